@@ -0,0 +1,714 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <lib/wstp_shim/wstp_shim.h>
+#include <mathematica_mathlink/mathematica_mathlink.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace local_wstp_shim {
+
+struct frame_type
+{
+  // A function whose arguments are still being put.
+  mathematica::detail::native_expression expr      { };
+  int                            remaining { };
+};
+
+struct packet_type
+{
+  int                                                id    { };
+  mathematica::detail::native_expression::argument_list_type items { };
+};
+
+std::mutex                            evaluator_mutex { };
+mathematica::wstp_shim::evaluator_type evaluator_default
+{
+  [](const mathematica::detail::native_expression& expr) { return mathematica::detail::native_evaluator { }.evaluate(expr); }
+};
+
+std::atomic<std::uint64_t> count_evaluations            { };
+std::atomic<std::uint64_t> count_evaluation_nanoseconds { };
+
+auto utf8_char_count(const std::string& str) -> int
+{
+  int count { };
+
+  for(const char c : str)
+  {
+    // Count every byte that is not a continuation byte.
+    if((static_cast<unsigned char>(c) & 0xC0U) != 0x80U)
+    {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+} // namespace local_wstp_shim
+
+struct ml_environment
+{
+  int reserved { };
+};
+
+struct MLink
+{
+  // The put side.
+  std::vector<local_wstp_shim::frame_type>         frames           { };
+  mathematica::detail::native_expression::argument_list_type completed        { };
+  bool                                             put_integer_next { false };
+
+  // The evaluation, which runs on its own thread (like a kernel would).
+  // The requests, the packets and the flags are guarded by the mutex.
+  std::mutex                                       mtx              { };
+  std::condition_variable                          cv               { };
+  std::deque<mathematica::detail::native_expression>       requests         { };
+  bool                                             evaluating       { false };
+  bool                                             abort_requested  { false };
+  bool                                             stopping         { false };
+  bool                                             dead             { false };
+  std::thread                                      worker           { };
+
+  // The get side.
+  std::deque<local_wstp_shim::packet_type>         packets          { };
+  mathematica::detail::native_expression::argument_list_type current          { };
+  std::size_t                                      current_index    { };
+  std::string                                      buffer_string    { };
+  std::string                                      buffer_symbol    { };
+  std::vector<std::int64_t>                        buffer_list      { };
+  int                                              error            { };
+
+  mathematica::wstp_shim::evaluator_type           evaluator        { };
+
+  MLink() = default;
+
+  MLink(const MLink&) = delete;
+  MLink(MLink&&) noexcept = delete;
+
+  ~MLink()
+  {
+    if(worker.joinable())
+    {
+      {
+        const std::lock_guard<std::mutex> lock { mtx };
+
+        stopping = true;
+      }
+
+      cv.notify_all();
+
+      worker.join();
+    }
+  }
+
+  auto operator=(const MLink&) -> MLink& = delete;
+  auto operator=(MLink&&) noexcept -> MLink& = delete;
+
+  auto submit(mathematica::detail::native_expression expr) -> bool
+  {
+    {
+      const std::lock_guard<std::mutex> lock { mtx };
+
+      if(dead)
+      {
+        return false;
+      }
+
+      requests.push_back(std::move(expr));
+
+      if(!worker.joinable())
+      {
+        worker = std::thread { [this]() { work(); } };
+      }
+    }
+
+    cv.notify_all();
+
+    return true;
+  }
+
+  auto work() -> void
+  {
+    // The allocations of the evaluations are those of the kernel.
+    const mathematica::allocation_site site { "wstp_shim" };
+
+    std::unique_lock<std::mutex> lock { mtx };
+
+    for(;;)
+    {
+      cv.wait(lock, [this]() { return (stopping || (!requests.empty())); });
+
+      if(stopping)
+      {
+        break;
+      }
+
+      const mathematica::detail::native_expression expr { std::move(requests.front()) };
+
+      requests.pop_front();
+
+      evaluating = true;
+
+      lock.unlock();
+
+      mathematica::detail::native_expression result { };
+
+      bool evaluate_is_ok { true };
+
+      try
+      {
+        result = evaluate(expr);
+      }
+      catch(...)
+      {
+        evaluate_is_ok = false;
+      }
+
+      lock.lock();
+
+      if(!evaluate_is_ok)
+      {
+        // An evaluator that throws brings the link down, as a crashing kernel
+        // would. Nothing is ever sent on the link again.
+        dead       = true;
+        evaluating = false;
+
+        requests.clear();
+
+        cv.notify_all();
+
+        break;
+      }
+
+      // An evaluation that was aborted while running returns $Aborted,
+      // just as it would in the kernel.
+      if(abort_requested)
+      {
+        result = mathematica::detail::native_expression::make_symbol("$Aborted");
+
+        abort_requested = false;
+      }
+
+      evaluating = false;
+
+      packets.push_back(local_wstp_shim::packet_type { mathematica::detail::RETURNPKT, { std::move(result) } });
+
+      cv.notify_all();
+    }
+  }
+
+  auto fail(const int error_code) -> int
+  {
+    // As in WSTP, the first error sticks until it is cleared with WSClearError().
+    // While an error is pending, the calls on the link fail.
+
+    if(error == mathematica::detail::WSEOK)
+    {
+      error = error_code;
+    }
+
+    return 0;
+  }
+
+  auto put_atom(mathematica::detail::native_expression expr) -> int
+  {
+    // Add a complete expression to the function being put. If that
+    // completes the function, then it is added to its parent in turn.
+
+    if(error != mathematica::detail::WSEOK)
+    {
+      return 0;
+    }
+
+    while(!frames.empty())
+    {
+      local_wstp_shim::frame_type& frm { frames.back() };
+
+      frm.expr.args.push_back(std::move(expr));
+
+      if(--frm.remaining != 0)
+      {
+        return 1;
+      }
+
+      expr = std::move(frm.expr);
+
+      frames.pop_back();
+    }
+
+    completed.push_back(std::move(expr));
+
+    return 1;
+  }
+
+  auto take_item() -> const mathematica::detail::native_expression*
+  {
+    if(error != mathematica::detail::WSEOK)
+    {
+      return nullptr;
+    }
+
+    if(current_index == current.size())
+    {
+      static_cast<void>(fail(mathematica::detail::WSEGSEQ));
+
+      return nullptr;
+    }
+
+    return &current[current_index++];
+  }
+
+  auto take_atom_text(std::string* p_str) -> bool
+  {
+    // As in WSTP, any atom can be read as a string.
+
+    const mathematica::detail::native_expression* p_item { take_item() };
+
+    if((p_item == nullptr) || (p_item->kind == mathematica::detail::native_expression_kind::function))
+    {
+      static_cast<void>(fail(mathematica::detail::WSEGBAD));
+
+      return false;
+    }
+
+    *p_str = p_item->atom_text();
+
+    return true;
+  }
+
+  auto evaluate(const mathematica::detail::native_expression& expr) -> mathematica::detail::native_expression
+  {
+    const auto start { std::chrono::steady_clock::now() };
+
+    mathematica::detail::native_expression result { evaluator(expr) };
+
+    const auto stop { std::chrono::steady_clock::now() };
+
+    local_wstp_shim::count_evaluations.fetch_add(1U);
+    local_wstp_shim::count_evaluation_nanoseconds.fetch_add(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count()));
+
+    return result;
+  }
+};
+
+namespace mathematica { namespace wstp_shim {
+
+auto set_evaluator(evaluator_type evaluator) -> void
+{
+  const std::lock_guard<std::mutex> lock { local_wstp_shim::evaluator_mutex };
+
+  local_wstp_shim::evaluator_default = std::move(evaluator);
+}
+
+auto statistics() -> statistics_type
+{
+  return statistics_type { local_wstp_shim::count_evaluations.load(), local_wstp_shim::count_evaluation_nanoseconds.load() };
+}
+
+} } // namespace mathematica::wstp_shim
+
+extern "C"
+{
+
+auto WSInitialize(WSEnvironmentParameter) -> WSEnvironment
+{
+  static ml_environment env { };
+
+  return &env;
+}
+
+auto WSDeinitialize(WSEnvironment) -> void { }
+
+auto WSOpen(int, char**) -> WSLINK
+{
+  // The arguments (such as the kernel location) are ignored.
+
+  WSLINK lnk { new MLink { } };
+
+  const std::lock_guard<std::mutex> lock { local_wstp_shim::evaluator_mutex };
+
+  lnk->evaluator = local_wstp_shim::evaluator_default;
+
+  return lnk;
+}
+
+auto WSClose(WSLINK lnk) -> int
+{
+  delete lnk;
+
+  return 1;
+}
+
+auto WSPutFunction(WSLINK lnk, const char* p_str_head, int argc) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  if(lnk->error != mathematica::detail::WSEOK)
+  {
+    return 0;
+  }
+
+  if(argc == 0)
+  {
+    return lnk->put_atom(mathematica::detail::native_expression::make_function(p_str_head, mathematica::detail::native_expression::argument_list_type { }));
+  }
+
+  lnk->frames.push_back(local_wstp_shim::frame_type { mathematica::detail::native_expression::make_function(p_str_head, mathematica::detail::native_expression::argument_list_type { }), argc });
+
+  return 1;
+}
+
+auto WSPutString(WSLINK lnk, const char* p_str) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  return lnk->put_atom(mathematica::detail::native_expression::make_string(p_str));
+}
+
+auto WSPutSymbol(WSLINK lnk, const char* p_str) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  return lnk->put_atom(mathematica::detail::native_expression::make_symbol(p_str));
+}
+
+auto WSPutInteger64(WSLINK lnk, std::int64_t n) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  return lnk->put_atom(mathematica::detail::native_expression::make_integer(mathematica::detail::native_integer { n }));
+}
+
+auto WSPutInteger64List(WSLINK lnk, const std::int64_t* p_list, int count) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  mathematica::detail::native_expression::argument_list_type elements { };
+
+  elements.reserve(static_cast<std::size_t>(count));
+
+  for(int index { 0 }; index < count; ++index)
+  {
+    elements.push_back(mathematica::detail::native_expression::make_integer(mathematica::detail::native_integer { p_list[index] })); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+
+  return lnk->put_atom(mathematica::detail::native_expression::make_function("List", std::move(elements)));
+}
+
+auto WSPutNext(WSLINK lnk, int type) -> int
+{
+  // Only integers given by their digits are supported.
+  lnk->put_integer_next = (type == mathematica::detail::WSTKINT);
+
+  return (lnk->put_integer_next ? 1 : lnk->fail(mathematica::detail::WSEPSEQ));
+}
+
+auto WSPutSize(WSLINK lnk, int) -> int
+{
+  return (lnk->put_integer_next ? 1 : 0);
+}
+
+auto WSPutData(WSLINK lnk, const char* p_data, int count) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  mathematica::detail::native_integer n { };
+
+  const bool
+    result_put_is_ok
+    {
+         lnk->put_integer_next
+      && mathematica::detail::native_integer::from_string(std::string(p_data, static_cast<std::size_t>(count)), 10U, &n)
+    };
+
+  lnk->put_integer_next = false;
+
+  return (result_put_is_ok ? lnk->put_atom(mathematica::detail::native_expression::make_integer(std::move(n))) : lnk->fail(mathematica::detail::WSEPSEQ));
+}
+
+auto WSEndPacket(WSLINK lnk) -> int
+{
+  // Evaluate each completed EvaluatePacket and queue its ReturnPacket.
+
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  if(lnk->error != mathematica::detail::WSEOK)
+  {
+    return 0;
+  }
+
+  if(!lnk->frames.empty())
+  {
+    return lnk->fail(mathematica::detail::WSEPSEQ);
+  }
+
+  bool submit_is_ok { true };
+
+  for(mathematica::detail::native_expression& expr : lnk->completed)
+  {
+    if(expr.is_function("EvaluatePacket") && (expr.args.size() == std::size_t { UINT8_C(1) }))
+    {
+      submit_is_ok = (lnk->submit(std::move(expr.args.front())) && submit_is_ok);
+    }
+  }
+
+  lnk->completed.clear();
+
+  // A submit fails only on a dead link.
+  return (submit_is_ok ? 1 : lnk->fail(mathematica::detail::WSEDEAD));
+}
+
+auto WSNextPacket(WSLINK lnk) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  lnk->current.clear();
+  lnk->current_index = std::size_t { UINT8_C(0) };
+
+  if(lnk->error != mathematica::detail::WSEOK)
+  {
+    return 0;
+  }
+
+  std::unique_lock<std::mutex> lock { lnk->mtx };
+
+  // Wait for the next packet, unless nothing is being evaluated at all.
+  lnk->cv.wait(lock, [lnk]() { return ((!lnk->packets.empty()) || lnk->dead || (lnk->requests.empty() && (!lnk->evaluating))); });
+
+  if(lnk->dead)
+  {
+    // There is no kernel that could ever send anything else.
+    return lnk->fail(mathematica::detail::WSEDEAD);
+  }
+
+  if(lnk->packets.empty())
+  {
+    // Nothing is being evaluated, so nothing could ever be read.
+    return lnk->fail(mathematica::detail::WSEGSEQ);
+  }
+
+  local_wstp_shim::packet_type pkt { std::move(lnk->packets.front()) };
+
+  lnk->packets.pop_front();
+
+  lock.unlock();
+
+  lnk->current = std::move(pkt.items);
+
+  return pkt.id;
+}
+
+auto WSNewPacket(WSLINK lnk) -> int
+{
+  // As in WSTP, this skips the rest of the current packet
+  // but leaves a pending error in place.
+
+  lnk->current.clear();
+  lnk->current_index = std::size_t { UINT8_C(0) };
+
+  return 1;
+}
+
+auto WSError(WSLINK lnk) -> int
+{
+  return lnk->error;
+}
+
+auto WSClearError(WSLINK lnk) -> int
+{
+  // The error of a dead link can not be cleared.
+
+  const std::lock_guard<std::mutex> lock { lnk->mtx };
+
+  if(lnk->dead)
+  {
+    lnk->error = mathematica::detail::WSEDEAD;
+
+    return 0;
+  }
+
+  lnk->error = mathematica::detail::WSEOK;
+
+  return 1;
+}
+
+auto WSReady(WSLINK lnk) -> int
+{
+  const std::lock_guard<std::mutex> lock { lnk->mtx };
+
+  // As in WSTP, a dead link is ready, so that reading from it fails at once.
+  return ((lnk->packets.empty() && (!lnk->dead)) ? 0 : 1);
+}
+
+auto WSFlush(WSLINK) -> int
+{
+  return 1;
+}
+
+auto WSPutMessage(WSLINK lnk, int msg) -> int
+{
+  // Only the abort message is supported. It aborts the evaluation
+  // that is currently running, if any.
+
+  if(msg == mathematica::detail::WSAbortMessage)
+  {
+    const std::lock_guard<std::mutex> lock { lnk->mtx };
+
+    lnk->abort_requested = lnk->evaluating;
+  }
+
+  return 1;
+}
+
+auto WSTestHead(WSLINK lnk, const char* p_str_head, int* p_argc) -> int
+{
+  // Descend into the function having the given head, so that
+  // its arguments are read next.
+
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  const mathematica::detail::native_expression* p_item { lnk->take_item() };
+
+  if((p_item == nullptr) || (!p_item->is_function(p_str_head)))
+  {
+    return lnk->fail(mathematica::detail::WSEGBAD);
+  }
+
+  mathematica::detail::native_expression::argument_list_type arguments { p_item->args };
+
+  *p_argc = static_cast<int>(arguments.size());
+
+  lnk->current.insert(lnk->current.begin() + static_cast<std::ptrdiff_t>(lnk->current_index),
+                      std::make_move_iterator(arguments.begin()),
+                      std::make_move_iterator(arguments.end()));
+
+  return 1;
+}
+
+auto WSGetString(WSLINK lnk, const char** pp_str) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  if(!lnk->take_atom_text(&lnk->buffer_string))
+  {
+    return 0;
+  }
+
+  *pp_str = lnk->buffer_string.c_str();
+
+  return 1;
+}
+
+auto WSReleaseString(WSLINK, const char*) -> void { }
+
+auto WSGetSymbol(WSLINK lnk, const char** pp_str) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  const mathematica::detail::native_expression* p_item { lnk->take_item() };
+
+  if((p_item == nullptr) || (!p_item->is_symbol()))
+  {
+    return lnk->fail(mathematica::detail::WSEGBAD);
+  }
+
+  lnk->buffer_symbol = p_item->str;
+
+  *pp_str = lnk->buffer_symbol.c_str();
+
+  return 1;
+}
+
+auto WSReleaseSymbol(WSLINK, const char*) -> void { }
+
+auto WSGetInteger64(WSLINK lnk, std::int64_t* p_value) -> int
+{
+  const mathematica::detail::native_expression* p_item { lnk->take_item() };
+
+  if((p_item == nullptr) || (!p_item->is_integer()) || (!p_item->integer.to_int64(p_value)))
+  {
+    return lnk->fail(mathematica::detail::WSEGBAD);
+  }
+
+  return 1;
+}
+
+auto WSGetReal64(WSLINK lnk, double* p_value) -> int
+{
+  const mathematica::detail::native_expression* p_item { lnk->take_item() };
+
+  if((p_item == nullptr) || ((!p_item->is_integer()) && (!p_item->is_real())))
+  {
+    return lnk->fail(mathematica::detail::WSEGBAD);
+  }
+
+  *p_value = (p_item->is_real() ? p_item->real : p_item->integer.to_double());
+
+  return 1;
+}
+
+auto WSGetInteger64List(WSLINK lnk, std::int64_t** pp_list, int* p_count) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  const mathematica::detail::native_expression* p_item { lnk->take_item() };
+
+  if((p_item == nullptr) || (!p_item->is_function("List")))
+  {
+    return lnk->fail(mathematica::detail::WSEGBAD);
+  }
+
+  lnk->buffer_list.resize(p_item->args.size());
+
+  for(std::size_t index { std::size_t { UINT8_C(0) } }; index < p_item->args.size(); ++index)
+  {
+    if((!p_item->args[index].is_integer()) || (!p_item->args[index].integer.to_int64(&lnk->buffer_list[index])))
+    {
+      return lnk->fail(mathematica::detail::WSEGBAD);
+    }
+  }
+
+  *pp_list = lnk->buffer_list.data();
+  *p_count = static_cast<int>(lnk->buffer_list.size());
+
+  return 1;
+}
+
+auto WSReleaseInteger64List(WSLINK, std::int64_t*, int) -> void { }
+
+auto WSGetUTF8String(WSLINK lnk, const unsigned char** pp_str, int* p_bytes, int* p_chars) -> int
+{
+  const mathematica::allocation_site site { "wstp_shim" };
+
+  if(!lnk->take_atom_text(&lnk->buffer_string))
+  {
+    return 0;
+  }
+
+  *pp_str  = reinterpret_cast<const unsigned char*>(lnk->buffer_string.c_str()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  *p_bytes = static_cast<int>(lnk->buffer_string.size());
+  *p_chars = local_wstp_shim::utf8_char_count(lnk->buffer_string);
+
+  return 1;
+}
+
+auto WSReleaseUTF8String(WSLINK, const unsigned char*, int) -> void { }
+
+} // extern "C"
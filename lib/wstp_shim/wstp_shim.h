@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef WSTP_SHIM_2026_10_16_H
+  #define WSTP_SHIM_2026_10_16_H
+
+  #include <mathematica_mathlink/detail/mathematica_native_evaluator.h>
+
+  #include <cstdint>
+  #include <functional>
+
+  // This is the stand-in WSTP shim. It implements the WS* functions declared
+  // in mathematica_mathlink.h without any kernel. The link in the shim builds
+  // up the expression that is put on it. Upon WSEndPacket(), the contents of
+  // EvaluatePacket[...] are evaluated in-process and the result is queued as
+  // a ReturnPacket, to be read back with WSNextPacket(), WSGetUTF8String(), etc.
+  // As in WSTP, an error sticks (and the calls on the link fail) until it
+  // is cleared with WSClearError(). The error of a dead link can not be cleared.
+
+  // By default, the evaluation is done with mathematica::detail::native_evaluator,
+  // which handles the command forms of the tests (PrimeQ, GCD, QuotientRemainder,
+  // IntegerString[FromDigits[...]], etc.). Link the tests with wstp_shim.cpp
+  // instead of wstp64i4 to build and to run them on systems without Mathematica.
+
+  namespace mathematica { namespace wstp_shim {
+
+  using evaluator_type = ::std::function<detail::native_expression(const detail::native_expression&)>;
+
+  struct statistics_type
+  {
+    ::std::uint64_t evaluations            { };
+    ::std::uint64_t evaluation_nanoseconds { };
+  };
+
+  // Replace the evaluator. This affects the links opened afterwards.
+  // An evaluator that throws brings its link down, as a crashing kernel would.
+  auto set_evaluator(evaluator_type evaluator) -> void;
+
+  // Get the number of evaluations and the time spent in the evaluator,
+  // so that the overhead of the harness can be told apart.
+  auto statistics() -> statistics_type;
+
+  } } // namespace mathematica::wstp_shim
+
+#endif // WSTP_SHIM_2026_10_16_H
@@ -0,0 +1,921 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_NATIVE_EVALUATOR_2026_10_16_H
+  #define MATHEMATICA_NATIVE_EVALUATOR_2026_10_16_H
+
+  #include <mathematica_mathlink/detail/mathematica_native_integer.h>
+
+  #include <chrono>
+  #include <cstddef>
+  #include <cstdint>
+  #include <iomanip>
+  #include <limits>
+  #include <sstream>
+  #include <string>
+  #include <unordered_map>
+  #include <utility>
+  #include <vector>
+
+  namespace mathematica { namespace detail {
+
+  enum class native_expression_kind
+  {
+    integer,
+    real,
+    string,
+    symbol,
+    function
+  };
+
+  struct native_expression
+  {
+    // This is an expression tree as evaluated natively. For a function,
+    // the string is the head and the arguments are the sub-expressions.
+    // For a string or a symbol, the string holds the string or symbol name.
+    // Machine reals only arise from AbsoluteTiming.
+
+    using argument_list_type = ::std::vector<native_expression>;
+
+    native_expression_kind kind    { native_expression_kind::symbol };
+    native_integer         integer { };
+    ::std::string          str     { };
+    argument_list_type     args    { };
+    double                 real    { };
+
+    static auto make_integer(native_integer n) -> native_expression
+    {
+      return native_expression { native_expression_kind::integer, ::std::move(n), ::std::string { }, argument_list_type { }, 0.0 };
+    }
+
+    static auto make_real(const double x) -> native_expression
+    {
+      return native_expression { native_expression_kind::real, native_integer { }, ::std::string { }, argument_list_type { }, x };
+    }
+
+    static auto make_string(::std::string str_value) -> native_expression
+    {
+      return native_expression { native_expression_kind::string, native_integer { }, ::std::move(str_value), argument_list_type { }, 0.0 };
+    }
+
+    static auto make_symbol(::std::string str_name) -> native_expression
+    {
+      return native_expression { native_expression_kind::symbol, native_integer { }, ::std::move(str_name), argument_list_type { }, 0.0 };
+    }
+
+    static auto make_function(::std::string str_head, argument_list_type arguments) -> native_expression
+    {
+      return native_expression { native_expression_kind::function, native_integer { }, ::std::move(str_head), ::std::move(arguments), 0.0 };
+    }
+
+    auto is_integer() const noexcept -> bool { return (kind == native_expression_kind::integer); }
+    auto is_real   () const noexcept -> bool { return (kind == native_expression_kind::real); }
+    auto is_string () const noexcept -> bool { return (kind == native_expression_kind::string); }
+    auto is_symbol () const noexcept -> bool { return (kind == native_expression_kind::symbol); }
+
+    auto is_function(const char* p_str_head) const -> bool
+    {
+      return ((kind == native_expression_kind::function) && (str == p_str_head));
+    }
+
+    auto atom_text() const -> ::std::string
+    {
+      // Get the text of an atom, as it is read from the link as a string.
+
+      if(is_real())
+      {
+        ::std::stringstream strm { };
+
+        strm << ::std::setprecision(::std::numeric_limits<double>::max_digits10) << real;
+
+        return strm.str();
+      }
+
+      return (is_integer() ? integer.to_string() : str);
+    }
+
+    auto to_string() const -> ::std::string
+    {
+      // Write the expression in a simple input form.
+
+      switch(kind)
+      {
+        case native_expression_kind::integer:
+        case native_expression_kind::real:
+          return atom_text();
+
+        case native_expression_kind::string:
+          return "\"" + str + "\"";
+
+        case native_expression_kind::function:
+        {
+          const bool is_list { (str == "List") };
+
+          ::std::string str_result { is_list ? ::std::string { "{" } : (str + "[") };
+
+          for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < args.size(); ++index)
+          {
+            str_result += ((index == ::std::size_t { UINT8_C(0) }) ? "" : ", ") + args[index].to_string();
+          }
+
+          return (str_result + (is_list ? "}" : "]"));
+        }
+
+        case native_expression_kind::symbol:
+        default:
+          return str;
+      }
+    }
+  };
+
+  class native_parser
+  {
+  public:
+    // This is the native_parser class. It parses the subset of the Wolfram
+    // Language input form that appears in commands sent with ToExpression:
+    // integers, strings, symbols, function calls f[a, b], lists {a, b},
+    // parentheses, the operators + - * ^ and a trailing semicolon.
+
+    static auto parse(const ::std::string& str, native_expression* p_expr) -> bool
+    {
+      native_parser parser { str };
+
+      native_expression expr { };
+
+      bool result_parse_is_ok { parser.parse_compound(&expr) };
+
+      if(result_parse_is_ok)
+      {
+        // The whole string must have been consumed.
+        parser.skip_space();
+
+        result_parse_is_ok = parser.at_end();
+      }
+
+      if(result_parse_is_ok)
+      {
+        *p_expr = ::std::move(expr);
+      }
+
+      return result_parse_is_ok;
+    }
+
+  private:
+    const ::std::string& my_str;
+    ::std::size_t        my_pos { };
+
+    explicit native_parser(const ::std::string& str) : my_str { str } { }
+
+    auto at_end() const noexcept -> bool { return (my_pos == my_str.size()); }
+
+    auto peek() const noexcept -> char { return (at_end() ? '\0' : my_str[my_pos]); }
+
+    auto skip_space() noexcept -> void
+    {
+      while((!at_end()) && ((peek() == ' ') || (peek() == '\t') || (peek() == '\n') || (peek() == '\r')))
+      {
+        ++my_pos;
+      }
+    }
+
+    auto accept(const char c) noexcept -> bool
+    {
+      skip_space();
+
+      const bool is_accepted { (peek() == c) };
+
+      if(is_accepted)
+      {
+        ++my_pos;
+      }
+
+      return is_accepted;
+    }
+
+    static auto is_digit      (const char c) noexcept -> bool { return ((c >= '0') && (c <= '9')); }
+    static auto is_letter     (const char c) noexcept -> bool { return (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '$')); }
+    static auto is_letter_like(const char c) noexcept -> bool { return (is_letter(c) || is_digit(c) || (c == '`')); }
+
+    auto parse_compound(native_expression* p_expr) -> bool
+    {
+      native_expression::argument_list_type parts { };
+
+      native_expression expr { };
+
+      if(!parse_sum(&expr))
+      {
+        return false;
+      }
+
+      parts.push_back(::std::move(expr));
+
+      while(accept(';'))
+      {
+        skip_space();
+
+        if(at_end() || (peek() == ')') || (peek() == ']') || (peek() == '}') || (peek() == ','))
+        {
+          parts.push_back(native_expression::make_symbol("Null"));
+
+          break;
+        }
+
+        if(!parse_sum(&expr))
+        {
+          return false;
+        }
+
+        parts.push_back(::std::move(expr));
+      }
+
+      *p_expr = ((parts.size() == ::std::size_t { UINT8_C(1) }) ? ::std::move(parts.front())
+                                                                : native_expression::make_function("CompoundExpression", ::std::move(parts)));
+
+      return true;
+    }
+
+    auto parse_sum(native_expression* p_expr) -> bool
+    {
+      native_expression::argument_list_type terms { };
+
+      native_expression term { };
+
+      if(!parse_product(&term))
+      {
+        return false;
+      }
+
+      terms.push_back(::std::move(term));
+
+      for(;;)
+      {
+        const bool is_plus  { accept('+') };
+        const bool is_minus { (!is_plus) && accept('-') };
+
+        if(!(is_plus || is_minus))
+        {
+          break;
+        }
+
+        if(!parse_product(&term))
+        {
+          return false;
+        }
+
+        terms.push_back(is_minus ? negated(::std::move(term)) : ::std::move(term));
+      }
+
+      *p_expr = ((terms.size() == ::std::size_t { UINT8_C(1) }) ? ::std::move(terms.front())
+                                                                : native_expression::make_function("Plus", ::std::move(terms)));
+
+      return true;
+    }
+
+    auto parse_product(native_expression* p_expr) -> bool
+    {
+      native_expression::argument_list_type factors { };
+
+      native_expression factor { };
+
+      if(!parse_unary(&factor))
+      {
+        return false;
+      }
+
+      factors.push_back(::std::move(factor));
+
+      while(accept('*'))
+      {
+        if(!parse_unary(&factor))
+        {
+          return false;
+        }
+
+        factors.push_back(::std::move(factor));
+      }
+
+      *p_expr = ((factors.size() == ::std::size_t { UINT8_C(1) }) ? ::std::move(factors.front())
+                                                                  : native_expression::make_function("Times", ::std::move(factors)));
+
+      return true;
+    }
+
+    auto parse_unary(native_expression* p_expr) -> bool
+    {
+      if(accept('-'))
+      {
+        native_expression operand { };
+
+        if(!parse_unary(&operand))
+        {
+          return false;
+        }
+
+        *p_expr = negated(::std::move(operand));
+
+        return true;
+      }
+
+      static_cast<void>(accept('+'));
+
+      return parse_power(p_expr);
+    }
+
+    auto parse_power(native_expression* p_expr) -> bool
+    {
+      native_expression base { };
+
+      if(!parse_postfix(&base))
+      {
+        return false;
+      }
+
+      if(accept('^'))
+      {
+        native_expression exponent { };
+
+        if(!parse_unary(&exponent))
+        {
+          return false;
+        }
+
+        *p_expr = native_expression::make_function("Power", native_expression::argument_list_type { ::std::move(base), ::std::move(exponent) });
+      }
+      else
+      {
+        *p_expr = ::std::move(base);
+      }
+
+      return true;
+    }
+
+    auto parse_postfix(native_expression* p_expr) -> bool
+    {
+      if(!parse_primary(p_expr))
+      {
+        return false;
+      }
+
+      while(accept('['))
+      {
+        if(!p_expr->is_symbol())
+        {
+          return false;
+        }
+
+        native_expression::argument_list_type arguments { };
+
+        if(!parse_arguments(']', &arguments))
+        {
+          return false;
+        }
+
+        *p_expr = native_expression::make_function(::std::move(p_expr->str), ::std::move(arguments));
+      }
+
+      return true;
+    }
+
+    auto parse_arguments(const char close, native_expression::argument_list_type* p_args) -> bool
+    {
+      if(accept(close))
+      {
+        return true;
+      }
+
+      for(;;)
+      {
+        native_expression arg { };
+
+        if(!parse_compound(&arg))
+        {
+          return false;
+        }
+
+        p_args->push_back(::std::move(arg));
+
+        if(accept(close))
+        {
+          return true;
+        }
+
+        if(!accept(','))
+        {
+          return false;
+        }
+      }
+    }
+
+    auto parse_primary(native_expression* p_expr) -> bool
+    {
+      skip_space();
+
+      const char c { peek() };
+
+      if(is_digit(c))
+      {
+        const ::std::size_t pos_first { my_pos };
+
+        while(is_digit(peek())) { ++my_pos; }
+
+        // Real numbers are not supported.
+        if(peek() == '.')
+        {
+          return false;
+        }
+
+        native_integer n { };
+
+        static_cast<void>(native_integer::from_string(my_str.substr(pos_first, my_pos - pos_first), unsigned { UINT8_C(10) }, &n));
+
+        *p_expr = native_expression::make_integer(::std::move(n));
+
+        return true;
+      }
+
+      if(is_letter(c))
+      {
+        const ::std::size_t pos_first { my_pos };
+
+        while(is_letter_like(peek())) { ++my_pos; }
+
+        *p_expr = native_expression::make_symbol(my_str.substr(pos_first, my_pos - pos_first));
+
+        return true;
+      }
+
+      if(c == '"')
+      {
+        ++my_pos;
+
+        ::std::string str_value { };
+
+        while((!at_end()) && (peek() != '"'))
+        {
+          if((peek() == '\\') && ((my_pos + 1U) < my_str.size()))
+          {
+            ++my_pos;
+          }
+
+          str_value.push_back(my_str[my_pos++]);
+        }
+
+        if(!accept('"'))
+        {
+          return false;
+        }
+
+        *p_expr = native_expression::make_string(::std::move(str_value));
+
+        return true;
+      }
+
+      if(accept('('))
+      {
+        return (parse_compound(p_expr) && accept(')'));
+      }
+
+      if(accept('{'))
+      {
+        native_expression::argument_list_type elements { };
+
+        const bool result_parse_is_ok { parse_arguments('}', &elements) };
+
+        *p_expr = native_expression::make_function("List", ::std::move(elements));
+
+        return result_parse_is_ok;
+      }
+
+      return false;
+    }
+
+    static auto negated(native_expression expr) -> native_expression
+    {
+      if(expr.is_integer())
+      {
+        return native_expression::make_integer(-expr.integer);
+      }
+
+      return native_expression::make_function("Times", native_expression::argument_list_type { native_expression::make_integer(native_integer { INT64_C(-1) }), ::std::move(expr) });
+    }
+  };
+
+  class native_evaluator
+  {
+  public:
+    // This is the native_evaluator class. It evaluates natively, with
+    // native_integer, the integer functions used in the tests:
+    // PrimeQ, GCD, QuotientRemainder, Quotient, Mod, First, Last, FromDigits,
+    // IntegerString, IntegerDigits, Plus, Times, Power, CompoundExpression
+    // and ToExpression. TimeConstrained and MemoryConstrained are accepted,
+    // but their budgets are not enforced. AbsoluteTiming holds its argument
+    // and times its evaluation. As in the kernel, an expression that cannot
+    // be evaluated is returned unevaluated.
+
+    using expression_type = native_expression;
+    using argument_list_type = typename expression_type::argument_list_type;
+
+    auto evaluate(const expression_type& expr) const -> expression_type
+    {
+      if(expr.kind != native_expression_kind::function)
+      {
+        return expr;
+      }
+
+      if(expr.is_function("AbsoluteTiming") && (expr.args.size() == ::std::size_t { UINT8_C(1) }))
+      {
+        return absolute_timing(expr.args.front());
+      }
+
+      argument_list_type arguments { };
+
+      arguments.reserve(expr.args.size());
+
+      for(const expression_type& arg : expr.args)
+      {
+        arguments.push_back(evaluate(arg));
+      }
+
+      const auto& builtins = builtin_table();
+
+      const auto itr = builtins.find(expr.str);
+
+      expression_type result { };
+
+      if((itr != builtins.end()) && (itr->second)(*this, arguments, &result))
+      {
+        return result;
+      }
+
+      return expression_type::make_function(expr.str, ::std::move(arguments));
+    }
+
+  private:
+    auto absolute_timing(const expression_type& expr) const -> expression_type
+    {
+      const auto start { ::std::chrono::steady_clock::now() };
+
+      expression_type result { evaluate(expr) };
+
+      const auto stop { ::std::chrono::steady_clock::now() };
+
+      const double seconds { ::std::chrono::duration_cast<::std::chrono::duration<double>>(stop - start).count() };
+
+      return expression_type::make_function("List", argument_list_type { expression_type::make_real(seconds), ::std::move(result) });
+    }
+
+    using builtin_type = bool(*)(const native_evaluator&, const argument_list_type&, expression_type*);
+
+    static auto builtin_table() -> const ::std::unordered_map<::std::string, builtin_type>&
+    {
+      static const ::std::unordered_map<::std::string, builtin_type>
+        builtins
+        {
+          { "CompoundExpression", &compound_expression },
+          { "ToExpression",       &to_expression },
+          { "PrimeQ",             &prime_q },
+          { "GCD",                &gcd },
+          { "QuotientRemainder",  &quotient_remainder },
+          { "Quotient",           &quotient },
+          { "Mod",                &mod },
+          { "First",              &first },
+          { "Last",               &last },
+          { "FromDigits",         &from_digits },
+          { "IntegerString",      &integer_string },
+          { "IntegerDigits",      &integer_digits },
+          { "Plus",               &plus },
+          { "Times",              &times },
+          { "Power",              &power },
+          { "TimeConstrained",    &constrained },
+          { "MemoryConstrained",  &constrained }
+        };
+
+      return builtins;
+    }
+
+    static auto all_integers(const argument_list_type& args) -> bool
+    {
+      for(const expression_type& arg : args)
+      {
+        if(!arg.is_integer())
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    static auto base_argument(const argument_list_type& args, native_integer* p_base) -> bool
+    {
+      // Get the optional base, being the second argument (10 by default).
+
+      *p_base = ((args.size() > ::std::size_t { UINT8_C(1) }) ? args[1U].integer : native_integer { INT64_C(10) });
+
+      return (   ((args.size() == ::std::size_t { UINT8_C(1) }) || ((args.size() == ::std::size_t { UINT8_C(2) }) && args[1U].is_integer()))
+              && (native_integer::compare(*p_base, native_integer { INT64_C(2) }) >= 0));
+    }
+
+    static auto compound_expression(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      *p_result = (args.empty() ? expression_type::make_symbol("Null") : args.back());
+
+      return true;
+    }
+
+    static auto to_expression(const native_evaluator& evaluator, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      // Both ToExpression[str] and ToExpression[str, form, h] are supported.
+      // In the latter form, the head h is wrapped around the parsed expression
+      // before it is evaluated.
+
+      const bool has_head { (args.size() == ::std::size_t { UINT8_C(3) }) && args[2U].is_symbol() };
+
+      if(   ((args.size() != ::std::size_t { UINT8_C(1) }) && (!has_head))
+         || (!args.front().is_string()))
+      {
+        return false;
+      }
+
+      expression_type expr { };
+
+      if(!native_parser::parse(args.front().str, &expr))
+      {
+        *p_result = expression_type::make_symbol("$Failed");
+
+        return true;
+      }
+
+      if(has_head)
+      {
+        expr = expression_type::make_function(args[2U].str, argument_list_type { ::std::move(expr) });
+      }
+
+      *p_result = evaluator.evaluate(expr);
+
+      return true;
+    }
+
+    static auto prime_q(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      if(args.size() != ::std::size_t { UINT8_C(1) })
+      {
+        return false;
+      }
+
+      const bool is_prime { (args.front().is_integer() && args.front().integer.abs().is_probable_prime()) };
+
+      *p_result = expression_type::make_symbol(is_prime ? "True" : "False");
+
+      return true;
+    }
+
+    static auto gcd(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      if(!all_integers(args))
+      {
+        return false;
+      }
+
+      native_integer result { };
+
+      for(const expression_type& arg : args)
+      {
+        result = native_integer::gcd(result, arg.integer);
+      }
+
+      *p_result = expression_type::make_integer(::std::move(result));
+
+      return true;
+    }
+
+    static auto quotient_remainder(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      native_integer quo { };
+      native_integer rem { };
+
+      if(   (args.size() != ::std::size_t { UINT8_C(2) })
+         || (!all_integers(args))
+         || (!native_integer::divmod_floor(args[0U].integer, args[1U].integer, &quo, &rem)))
+      {
+        return false;
+      }
+
+      *p_result =
+        expression_type::make_function
+        (
+          "List",
+          argument_list_type { expression_type::make_integer(::std::move(quo)), expression_type::make_integer(::std::move(rem)) }
+        );
+
+      return true;
+    }
+
+    static auto quotient(const native_evaluator& evaluator, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      return (quotient_remainder(evaluator, args, p_result) && first(evaluator, argument_list_type { *p_result }, p_result));
+    }
+
+    static auto mod(const native_evaluator& evaluator, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      return (quotient_remainder(evaluator, args, p_result) && last(evaluator, argument_list_type { *p_result }, p_result));
+    }
+
+    static auto constrained(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      // The expression has already been evaluated, without any budget.
+
+      if(args.size() < ::std::size_t { UINT8_C(2) })
+      {
+        return false;
+      }
+
+      *p_result = args.front();
+
+      return true;
+    }
+
+    static auto first(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      if((args.size() != ::std::size_t { UINT8_C(1) }) || (args.front().kind != native_expression_kind::function) || args.front().args.empty())
+      {
+        return false;
+      }
+
+      *p_result = args.front().args.front();
+
+      return true;
+    }
+
+    static auto last(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      if((args.size() != ::std::size_t { UINT8_C(1) }) || (args.front().kind != native_expression_kind::function) || args.front().args.empty())
+      {
+        return false;
+      }
+
+      *p_result = args.front().args.back();
+
+      return true;
+    }
+
+    static auto from_digits(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      native_integer base { };
+
+      if(args.empty() || (!base_argument(args, &base)))
+      {
+        return false;
+      }
+
+      native_integer result { };
+
+      if(args.front().is_string())
+      {
+        ::std::int64_t base64 { };
+
+        if(   (!base.to_int64(&base64))
+           || (base64 > ::std::int64_t { INT8_C(36) })
+           || (!native_integer::from_string(args.front().str, static_cast<unsigned>(base64), &result)))
+        {
+          return false;
+        }
+      }
+      else if(args.front().is_function("List") && all_integers(args.front().args))
+      {
+        ::std::vector<native_integer> digits { };
+
+        digits.reserve(args.front().args.size());
+
+        for(const expression_type& digit : args.front().args)
+        {
+          digits.push_back(digit.integer);
+        }
+
+        result = native_integer::from_digits(digits, base);
+      }
+      else
+      {
+        return false;
+      }
+
+      *p_result = expression_type::make_integer(::std::move(result));
+
+      return true;
+    }
+
+    static auto integer_string(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      native_integer base { };
+
+      ::std::int64_t base64 { };
+
+      if(   args.empty()
+         || (!args.front().is_integer())
+         || (!base_argument(args, &base))
+         || (!base.to_int64(&base64))
+         || (base64 > ::std::int64_t { INT8_C(36) }))
+      {
+        return false;
+      }
+
+      // As in the kernel, the sign is not part of the string.
+      *p_result = expression_type::make_string(args.front().integer.abs().to_string(static_cast<unsigned>(base64)));
+
+      return true;
+    }
+
+    static auto integer_digits(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      native_integer base { };
+
+      ::std::vector<native_integer> digits { };
+
+      if(   args.empty()
+         || (!args.front().is_integer())
+         || (!base_argument(args, &base))
+         || (!args.front().integer.to_digits(base, &digits)))
+      {
+        return false;
+      }
+
+      argument_list_type elements { };
+
+      elements.reserve(digits.size());
+
+      for(native_integer& digit : digits)
+      {
+        elements.push_back(expression_type::make_integer(::std::move(digit)));
+      }
+
+      *p_result = expression_type::make_function("List", ::std::move(elements));
+
+      return true;
+    }
+
+    static auto plus(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      if(!all_integers(args))
+      {
+        return false;
+      }
+
+      native_integer result { };
+
+      for(const expression_type& arg : args)
+      {
+        result = result + arg.integer;
+      }
+
+      *p_result = expression_type::make_integer(::std::move(result));
+
+      return true;
+    }
+
+    static auto times(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      if(!all_integers(args))
+      {
+        return false;
+      }
+
+      native_integer result { INT64_C(1) };
+
+      for(const expression_type& arg : args)
+      {
+        result = result * arg.integer;
+      }
+
+      *p_result = expression_type::make_integer(::std::move(result));
+
+      return true;
+    }
+
+    static auto power(const native_evaluator&, const argument_list_type& args, expression_type* p_result) -> bool
+    {
+      // The kernel answers 0^0 with Indeterminate (and a message), which is declined here.
+
+      ::std::int64_t exponent { };
+
+      if(   (args.size() != ::std::size_t { UINT8_C(2) })
+         || (!all_integers(args))
+         || (!args[1U].integer.to_int64(&exponent))
+         || (exponent < ::std::int64_t { INT8_C(0) })
+         || (args[0U].integer.is_zero() && (exponent == ::std::int64_t { INT8_C(0) })))
+      {
+        return false;
+      }
+
+      *p_result = expression_type::make_integer(native_integer::pow(args[0U].integer, static_cast<::std::uint64_t>(exponent)));
+
+      return true;
+    }
+  };
+
+  } } // namespace mathematica::detail
+
+#endif // MATHEMATICA_NATIVE_EVALUATOR_2026_10_16_H
@@ -0,0 +1,1031 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_NATIVE_INTEGER_2026_10_16_H
+  #define MATHEMATICA_NATIVE_INTEGER_2026_10_16_H
+
+  #include <algorithm>
+  #include <array>
+  #include <cstddef>
+  #include <cstdint>
+  #include <limits>
+  #include <string>
+  #include <utility>
+  #include <vector>
+
+  namespace mathematica { namespace detail {
+
+  class native_integer
+  {
+  public:
+    // This is the native_integer class. It is a small, self-contained signed
+    // integer of arbitrary size, being the native arithmetic engine behind the
+    // stand-in evaluators of the command forms used in the tests. It is kept
+    // independent of the multiple-precision libraries under test on purpose.
+
+    // The magnitude is held in base-2^32 limbs, least significant limb first,
+    // without leading zero limbs. Zero has no limbs and is never negative.
+
+    using limb_type        = ::std::uint32_t;
+    using double_limb_type = ::std::uint64_t;
+    using limb_list_type   = ::std::vector<limb_type>;
+
+    native_integer() = default;
+
+    explicit native_integer(const ::std::int64_t n)
+      : my_neg { (n < ::std::int64_t { INT8_C(0) }) }
+    {
+      ::std::uint64_t u { my_neg ? static_cast<::std::uint64_t>(~static_cast<::std::uint64_t>(n) + 1U) : static_cast<::std::uint64_t>(n) };
+
+      while(u != ::std::uint64_t { UINT8_C(0) })
+      {
+        my_mag.push_back(static_cast<limb_type>(u));
+
+        u >>= 32U;
+      }
+    }
+
+    static auto from_string(const ::std::string& str, const unsigned base, native_integer* p_result) -> bool
+    {
+      // Read an integer from its digits in the given base (2...36),
+      // with an optional leading sign. The letters are case-insensitive.
+
+      if((base < unsigned { UINT8_C(2) }) || (base > unsigned { UINT8_C(36) }))
+      {
+        return false;
+      }
+
+      ::std::size_t pos { ::std::size_t { UINT8_C(0) } };
+
+      const bool is_neg { ((!str.empty()) && (str.front() == '-')) };
+
+      if((!str.empty()) && ((str.front() == '-') || (str.front() == '+')))
+      {
+        ++pos;
+      }
+
+      if(pos == str.size())
+      {
+        return false;
+      }
+
+      native_integer result { };
+
+      // Accumulate as many digits as fit into one limb at a time.
+      limb_type chunk_mul { UINT8_C(1) };
+      limb_type chunk_val { UINT8_C(0) };
+
+      for( ; pos < str.size(); ++pos)
+      {
+        const unsigned digit { digit_value(str[pos]) };
+
+        if(digit >= base)
+        {
+          return false;
+        }
+
+        if((static_cast<double_limb_type>(chunk_mul) * base) > double_limb_type { UINT32_MAX })
+        {
+          mul_add_small(result.my_mag, chunk_mul, chunk_val);
+
+          chunk_mul = limb_type { UINT8_C(1) };
+          chunk_val = limb_type { UINT8_C(0) };
+        }
+
+        chunk_mul = static_cast<limb_type>(chunk_mul * base);
+        chunk_val = static_cast<limb_type>((chunk_val * base) + digit);
+      }
+
+      mul_add_small(result.my_mag, chunk_mul, chunk_val);
+
+      result.my_neg = (is_neg && (!result.is_zero()));
+
+      *p_result = ::std::move(result);
+
+      return true;
+    }
+
+    static auto from_digits(const ::std::vector<native_integer>& digits, const native_integer& base) -> native_integer
+    {
+      // Compose an integer from its digits, most significant digit first.
+      // As in FromDigits, the digits need not be less than the base.
+
+      native_integer result { };
+
+      for(const native_integer& digit : digits)
+      {
+        result = (result * base) + digit;
+      }
+
+      return result;
+    }
+
+    auto to_string(const unsigned base = unsigned { UINT8_C(10) }) const -> ::std::string
+    {
+      // Write the digits of the integer in the given base (2...36),
+      // with lowercase letters, as in IntegerString and ToString.
+
+      if(is_zero() || (base < unsigned { UINT8_C(2) }) || (base > unsigned { UINT8_C(36) }))
+      {
+        return ::std::string { "0" };
+      }
+
+      // Divide by the largest power of the base that fits into one limb.
+      limb_type chunk_div    { base };
+      unsigned  chunk_digits { UINT8_C(1) };
+
+      while((static_cast<double_limb_type>(chunk_div) * base) <= double_limb_type { UINT32_MAX })
+      {
+        chunk_div = static_cast<limb_type>(chunk_div * base);
+
+        ++chunk_digits;
+      }
+
+      limb_list_type mag { my_mag };
+
+      ::std::string str { };
+
+      while(!mag.empty())
+      {
+        limb_type chunk { div_small(mag, chunk_div) };
+
+        for(unsigned index { UINT8_C(0) }; index < chunk_digits; ++index)
+        {
+          if(mag.empty() && (chunk == limb_type { UINT8_C(0) }))
+          {
+            break;
+          }
+
+          str.push_back(digit_char(static_cast<unsigned>(chunk % base)));
+
+          chunk = static_cast<limb_type>(chunk / base);
+        }
+      }
+
+      if(my_neg)
+      {
+        str.push_back('-');
+      }
+
+      ::std::reverse(str.begin(), str.end());
+
+      return str;
+    }
+
+    auto to_digits(const native_integer& base, ::std::vector<native_integer>* p_digits) const -> bool
+    {
+      // Get the digits of the magnitude of the integer in the given
+      // base (at least 2), most significant digit first, as in IntegerDigits.
+
+      if(base.my_neg || (compare(base, native_integer { INT64_C(2) }) < 0))
+      {
+        return false;
+      }
+
+      p_digits->clear();
+
+      native_integer mag { abs() };
+
+      while(!mag.is_zero())
+      {
+        native_integer quo { };
+        native_integer rem { };
+
+        static_cast<void>(divmod_floor(mag, base, &quo, &rem));
+
+        p_digits->push_back(::std::move(rem));
+
+        mag = ::std::move(quo);
+      }
+
+      if(p_digits->empty())
+      {
+        p_digits->push_back(native_integer { });
+      }
+
+      ::std::reverse(p_digits->begin(), p_digits->end());
+
+      return true;
+    }
+
+    auto to_int64(::std::int64_t* p_value) const noexcept -> bool
+    {
+      if(my_mag.size() > ::std::size_t { UINT8_C(2) })
+      {
+        return false;
+      }
+
+      ::std::uint64_t u { };
+
+      for(::std::size_t index { my_mag.size() }; index > ::std::size_t { UINT8_C(0) }; --index)
+      {
+        u = static_cast<::std::uint64_t>((u << 32U) | my_mag[index - 1U]);
+      }
+
+      const ::std::uint64_t u_max { static_cast<::std::uint64_t>((::std::numeric_limits<::std::int64_t>::max)()) };
+
+      if(u > (my_neg ? static_cast<::std::uint64_t>(u_max + 1U) : u_max))
+      {
+        return false;
+      }
+
+      *p_value = (my_neg ? static_cast<::std::int64_t>(~u + 1U) : static_cast<::std::int64_t>(u));
+
+      return true;
+    }
+
+    auto to_double() const noexcept -> double
+    {
+      double result { };
+
+      for(::std::size_t index { my_mag.size() }; index > ::std::size_t { UINT8_C(0) }; --index)
+      {
+        result = (result * 4294967296.0) + static_cast<double>(my_mag[index - 1U]);
+      }
+
+      return (my_neg ? -result : result);
+    }
+
+    auto is_zero    () const noexcept -> bool                  { return my_mag.empty(); }
+    auto is_negative() const noexcept -> bool                  { return my_neg; }
+    auto is_odd     () const noexcept -> bool                  { return ((!my_mag.empty()) && ((my_mag.front() & 1U) != 0U)); }
+    auto limbs      () const noexcept -> const limb_list_type& { return my_mag; }
+
+    auto abs() const -> native_integer
+    {
+      native_integer result { *this };
+
+      result.my_neg = false;
+
+      return result;
+    }
+
+    auto operator-() const -> native_integer
+    {
+      native_integer result { *this };
+
+      result.my_neg = ((!result.is_zero()) && (!my_neg));
+
+      return result;
+    }
+
+    friend auto operator+(const native_integer& a, const native_integer& b) -> native_integer
+    {
+      native_integer result { };
+
+      if(a.my_neg == b.my_neg)
+      {
+        result.my_mag = add_mag(a.my_mag, b.my_mag);
+        result.my_neg = a.my_neg;
+      }
+      else if(compare_mag(a.my_mag, b.my_mag) >= 0)
+      {
+        result.my_mag = sub_mag(a.my_mag, b.my_mag);
+        result.my_neg = a.my_neg;
+      }
+      else
+      {
+        result.my_mag = sub_mag(b.my_mag, a.my_mag);
+        result.my_neg = b.my_neg;
+      }
+
+      result.my_neg = (result.my_neg && (!result.is_zero()));
+
+      return result;
+    }
+
+    friend auto operator-(const native_integer& a, const native_integer& b) -> native_integer
+    {
+      return a + (-b);
+    }
+
+    friend auto operator*(const native_integer& a, const native_integer& b) -> native_integer
+    {
+      native_integer result { };
+
+      result.my_mag = mul_mag(a.my_mag, b.my_mag);
+      result.my_neg = ((a.my_neg != b.my_neg) && (!result.is_zero()));
+
+      return result;
+    }
+
+    friend auto operator==(const native_integer& a, const native_integer& b) noexcept -> bool { return ((a.my_neg == b.my_neg) && (a.my_mag == b.my_mag)); }
+    friend auto operator!=(const native_integer& a, const native_integer& b) noexcept -> bool { return (!(a == b)); }
+
+    static auto compare(const native_integer& a, const native_integer& b) noexcept -> int
+    {
+      if(a.my_neg != b.my_neg)
+      {
+        return (a.my_neg ? -1 : 1);
+      }
+
+      const int result_mag { compare_mag(a.my_mag, b.my_mag) };
+
+      return (a.my_neg ? -result_mag : result_mag);
+    }
+
+    static auto divmod_floor(const native_integer& a, const native_integer& b, native_integer* p_quo, native_integer* p_rem) -> bool
+    {
+      // Divide with the quotient rounded toward minus infinity. The remainder
+      // then has the sign of the divisor, as in QuotientRemainder and Mod.
+
+      if(b.is_zero())
+      {
+        return false;
+      }
+
+      native_integer quo { };
+      native_integer rem { };
+
+      divmod_mag(a.my_mag, b.my_mag, &quo.my_mag, &rem.my_mag);
+
+      quo.my_neg = ((a.my_neg != b.my_neg) && (!quo.is_zero()));
+      rem.my_neg = (a.my_neg && (!rem.is_zero()));
+
+      if((!rem.is_zero()) && (rem.my_neg != b.my_neg))
+      {
+        quo = quo - native_integer { INT64_C(1) };
+        rem = rem + b;
+      }
+
+      if(p_quo != nullptr) { *p_quo = ::std::move(quo); }
+      if(p_rem != nullptr) { *p_rem = ::std::move(rem); }
+
+      return true;
+    }
+
+    static auto mod(const native_integer& a, const native_integer& n) -> native_integer
+    {
+      native_integer rem { };
+
+      static_cast<void>(divmod_floor(a, n, nullptr, &rem));
+
+      return rem;
+    }
+
+    static auto gcd(native_integer a, native_integer b) -> native_integer
+    {
+      a.my_neg = false;
+      b.my_neg = false;
+
+      while(!b.is_zero())
+      {
+        native_integer rem { mod(a, b) };
+
+        a = ::std::move(b);
+        b = ::std::move(rem);
+      }
+
+      return a;
+    }
+
+    static auto pow(const native_integer& base, ::std::uint64_t exponent) -> native_integer
+    {
+      native_integer result { INT64_C(1) };
+      native_integer x      { base };
+
+      while(exponent != ::std::uint64_t { UINT8_C(0) })
+      {
+        if((exponent & 1U) != ::std::uint64_t { UINT8_C(0) })
+        {
+          result = result * x;
+        }
+
+        exponent >>= 1U;
+
+        if(exponent != ::std::uint64_t { UINT8_C(0) })
+        {
+          x = x * x;
+        }
+      }
+
+      return result;
+    }
+
+    auto is_probable_prime() const -> bool
+    {
+      // This is the Baillie-PSW test, being a strong probable prime test
+      // to base 2 followed by a strong Lucas probable prime test with
+      // the parameters of Selfridge. It has no known counterexample.
+
+      if(my_neg || (compare(*this, native_integer { INT64_C(2) }) < 0))
+      {
+        return false;
+      }
+
+      constexpr ::std::array<limb_type, ::std::size_t { UINT8_C(25) }>
+        small_primes
+        {
+           2U,  3U,  5U,  7U, 11U, 13U, 17U, 19U, 23U, 29U, 31U, 37U, 41U,
+          43U, 47U, 53U, 59U, 61U, 67U, 71U, 73U, 79U, 83U, 89U, 97U
+        };
+
+      for(const limb_type p : small_primes)
+      {
+        if((my_mag.size() == ::std::size_t { UINT8_C(1) }) && (my_mag.front() == p))
+        {
+          return true;
+        }
+
+        limb_list_type mag { my_mag };
+
+        if(div_small(mag, p) == limb_type { UINT8_C(0) })
+        {
+          return false;
+        }
+      }
+
+      // Every composite below 97^2 has a factor in the table.
+      if(compare(*this, native_integer { INT64_C(9409) }) < 0)
+      {
+        return true;
+      }
+
+      return (is_strong_probable_prime_base_2() && is_strong_lucas_probable_prime());
+    }
+
+  private:
+    bool           my_neg { false };
+    limb_list_type my_mag { };
+
+    static auto digit_value(const char c) noexcept -> unsigned
+    {
+      if((c >= '0') && (c <= '9')) { return static_cast<unsigned>(c - '0'); }
+      if((c >= 'a') && (c <= 'z')) { return static_cast<unsigned>(c - 'a') + 10U; }
+      if((c >= 'A') && (c <= 'Z')) { return static_cast<unsigned>(c - 'A') + 10U; }
+
+      return (::std::numeric_limits<unsigned>::max)();
+    }
+
+    static auto digit_char(const unsigned digit) noexcept -> char
+    {
+      return ((digit < 10U) ? static_cast<char>('0' + static_cast<char>(digit))
+                            : static_cast<char>('a' + static_cast<char>(digit - 10U)));
+    }
+
+    static auto trim(limb_list_type& mag) -> void
+    {
+      while((!mag.empty()) && (mag.back() == limb_type { UINT8_C(0) }))
+      {
+        mag.pop_back();
+      }
+    }
+
+    static auto compare_mag(const limb_list_type& a, const limb_list_type& b) noexcept -> int
+    {
+      if(a.size() != b.size())
+      {
+        return ((a.size() < b.size()) ? -1 : 1);
+      }
+
+      for(::std::size_t index { a.size() }; index > ::std::size_t { UINT8_C(0) }; --index)
+      {
+        if(a[index - 1U] != b[index - 1U])
+        {
+          return ((a[index - 1U] < b[index - 1U]) ? -1 : 1);
+        }
+      }
+
+      return 0;
+    }
+
+    static auto add_mag(const limb_list_type& a, const limb_list_type& b) -> limb_list_type
+    {
+      const limb_list_type& lo { (a.size() < b.size()) ? a : b };
+      const limb_list_type& hi { (a.size() < b.size()) ? b : a };
+
+      limb_list_type result(hi.size() + 1U, limb_type { UINT8_C(0) });
+
+      double_limb_type carry { };
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < hi.size(); ++index)
+      {
+        carry += hi[index];
+
+        if(index < lo.size()) { carry += lo[index]; }
+
+        result[index] = static_cast<limb_type>(carry);
+
+        carry >>= 32U;
+      }
+
+      result.back() = static_cast<limb_type>(carry);
+
+      trim(result);
+
+      return result;
+    }
+
+    static auto sub_mag(const limb_list_type& a, const limb_list_type& b) -> limb_list_type
+    {
+      // Subtract the magnitudes, where a >= b.
+
+      limb_list_type result(a.size(), limb_type { UINT8_C(0) });
+
+      ::std::int64_t borrow { };
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < a.size(); ++index)
+      {
+        ::std::int64_t diff { static_cast<::std::int64_t>(a[index]) - borrow };
+
+        if(index < b.size()) { diff -= static_cast<::std::int64_t>(b[index]); }
+
+        borrow = ((diff < ::std::int64_t { INT8_C(0) }) ? ::std::int64_t { INT8_C(1) } : ::std::int64_t { INT8_C(0) });
+
+        result[index] = static_cast<limb_type>(diff + (borrow << 32U));
+      }
+
+      trim(result);
+
+      return result;
+    }
+
+    static auto mul_mag(const limb_list_type& a, const limb_list_type& b) -> limb_list_type
+    {
+      if(a.empty() || b.empty())
+      {
+        return limb_list_type { };
+      }
+
+      limb_list_type result(a.size() + b.size(), limb_type { UINT8_C(0) });
+
+      for(::std::size_t i { ::std::size_t { UINT8_C(0) } }; i < a.size(); ++i)
+      {
+        double_limb_type carry { };
+
+        for(::std::size_t j { ::std::size_t { UINT8_C(0) } }; j < b.size(); ++j)
+        {
+          carry += (static_cast<double_limb_type>(a[i]) * b[j]) + result[i + j];
+
+          result[i + j] = static_cast<limb_type>(carry);
+
+          carry >>= 32U;
+        }
+
+        result[i + b.size()] = static_cast<limb_type>(carry);
+      }
+
+      trim(result);
+
+      return result;
+    }
+
+    static auto mul_add_small(limb_list_type& mag, const limb_type m, const limb_type a) -> void
+    {
+      double_limb_type carry { a };
+
+      for(limb_type& limb : mag)
+      {
+        carry += static_cast<double_limb_type>(limb) * m;
+
+        limb = static_cast<limb_type>(carry);
+
+        carry >>= 32U;
+      }
+
+      if(carry != double_limb_type { UINT8_C(0) })
+      {
+        mag.push_back(static_cast<limb_type>(carry));
+      }
+    }
+
+    static auto div_small(limb_list_type& mag, const limb_type d) -> limb_type
+    {
+      // Divide the magnitude in place and return the remainder.
+
+      double_limb_type rem { };
+
+      for(::std::size_t index { mag.size() }; index > ::std::size_t { UINT8_C(0) }; --index)
+      {
+        const double_limb_type cur { static_cast<double_limb_type>((rem << 32U) | mag[index - 1U]) };
+
+        mag[index - 1U] = static_cast<limb_type>(cur / d);
+
+        rem = static_cast<double_limb_type>(cur % d);
+      }
+
+      trim(mag);
+
+      return static_cast<limb_type>(rem);
+    }
+
+    static auto divmod_mag(const limb_list_type& u, const limb_list_type& v, limb_list_type* p_quo, limb_list_type* p_rem) -> void
+    {
+      // This is Knuth's algorithm D (TAOCP Vol. 2, 4.3.1)
+      // for the division of the magnitudes, where v is non-zero.
+
+      if(compare_mag(u, v) < 0)
+      {
+        *p_quo = limb_list_type { };
+        *p_rem = u;
+
+        return;
+      }
+
+      if(v.size() == ::std::size_t { UINT8_C(1) })
+      {
+        *p_quo = u;
+
+        const limb_type rem { div_small(*p_quo, v.front()) };
+
+        *p_rem = ((rem != limb_type { UINT8_C(0) }) ? limb_list_type { rem } : limb_list_type { });
+
+        return;
+      }
+
+      const ::std::size_t n { v.size() };
+      const ::std::size_t m { u.size() - n };
+
+      // Normalize, such that the highest limb of the divisor has its high bit set.
+      unsigned shift { };
+
+      for(limb_type top { v.back() }; (top & UINT32_C(0x80000000)) == 0U; top = static_cast<limb_type>(top << 1U))
+      {
+        ++shift;
+      }
+
+      limb_list_type vn(n,      limb_type { UINT8_C(0) });
+      limb_list_type un(m + n + 1U, limb_type { UINT8_C(0) });
+
+      for(::std::size_t index { n - 1U }; index > ::std::size_t { UINT8_C(0) }; --index)
+      {
+        vn[index] = static_cast<limb_type>((v[index] << shift) | ((shift != 0U) ? (v[index - 1U] >> (32U - shift)) : 0U));
+      }
+
+      vn.front() = static_cast<limb_type>(v.front() << shift);
+
+      un.back() = ((shift != 0U) ? static_cast<limb_type>(u.back() >> (32U - shift)) : limb_type { UINT8_C(0) });
+
+      for(::std::size_t index { m + n - 1U }; index > ::std::size_t { UINT8_C(0) }; --index)
+      {
+        un[index] = static_cast<limb_type>((u[index] << shift) | ((shift != 0U) ? (u[index - 1U] >> (32U - shift)) : 0U));
+      }
+
+      un.front() = static_cast<limb_type>(u.front() << shift);
+
+      limb_list_type quo(m + 1U, limb_type { UINT8_C(0) });
+
+      constexpr double_limb_type radix { UINT64_C(0x100000000) };
+
+      for(::std::size_t jj { m + 1U }; jj > ::std::size_t { UINT8_C(0) }; --jj)
+      {
+        const ::std::size_t j { jj - 1U };
+
+        // Estimate the quotient limb and correct the estimate.
+        const double_limb_type num { static_cast<double_limb_type>((static_cast<double_limb_type>(un[j + n]) << 32U) | un[j + n - 1U]) };
+
+        double_limb_type qhat { num / vn[n - 1U] };
+        double_limb_type rhat { num % vn[n - 1U] };
+
+        while((qhat >= radix) || ((qhat * vn[n - 2U]) > ((rhat << 32U) | un[j + n - 2U])))
+        {
+          --qhat;
+
+          rhat += vn[n - 1U];
+
+          if(rhat >= radix)
+          {
+            break;
+          }
+        }
+
+        // Multiply and subtract.
+        ::std::int64_t borrow { };
+
+        double_limb_type carry { };
+
+        for(::std::size_t i { ::std::size_t { UINT8_C(0) } }; i < n; ++i)
+        {
+          const double_limb_type prod { (qhat * vn[i]) + carry };
+
+          carry = (prod >> 32U);
+
+          const ::std::int64_t diff { static_cast<::std::int64_t>(un[i + j]) - static_cast<::std::int64_t>(prod & UINT32_MAX) - borrow };
+
+          borrow = ((diff < ::std::int64_t { INT8_C(0) }) ? ::std::int64_t { INT8_C(1) } : ::std::int64_t { INT8_C(0) });
+
+          un[i + j] = static_cast<limb_type>(diff + (borrow << 32U));
+        }
+
+        const ::std::int64_t diff_top { static_cast<::std::int64_t>(un[j + n]) - static_cast<::std::int64_t>(carry) - borrow };
+
+        un[j + n] = static_cast<limb_type>(diff_top);
+
+        quo[j] = static_cast<limb_type>(qhat);
+
+        if(diff_top < ::std::int64_t { INT8_C(0) })
+        {
+          // The estimate was one too large. Add the divisor back.
+          --quo[j];
+
+          double_limb_type carry_add { };
+
+          for(::std::size_t i { ::std::size_t { UINT8_C(0) } }; i < n; ++i)
+          {
+            carry_add += static_cast<double_limb_type>(un[i + j]) + vn[i];
+
+            un[i + j] = static_cast<limb_type>(carry_add);
+
+            carry_add >>= 32U;
+          }
+
+          un[j + n] = static_cast<limb_type>(un[j + n] + carry_add);
+        }
+      }
+
+      // Denormalize the remainder.
+      limb_list_type rem(n, limb_type { UINT8_C(0) });
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < n; ++index)
+      {
+        rem[index] = static_cast<limb_type>((un[index] >> shift) | ((shift != 0U) ? static_cast<limb_type>(un[index + 1U] << (32U - shift)) : 0U));
+      }
+
+      trim(quo);
+      trim(rem);
+
+      *p_quo = ::std::move(quo);
+      *p_rem = ::std::move(rem);
+    }
+
+    auto bit_length() const noexcept -> ::std::size_t
+    {
+      if(my_mag.empty())
+      {
+        return ::std::size_t { UINT8_C(0) };
+      }
+
+      ::std::size_t bits { (my_mag.size() - 1U) * 32U };
+
+      for(limb_type top { my_mag.back() }; top != limb_type { UINT8_C(0) }; top >>= 1U)
+      {
+        ++bits;
+      }
+
+      return bits;
+    }
+
+    auto test_bit(const ::std::size_t bit) const noexcept -> bool
+    {
+      const ::std::size_t index { bit / 32U };
+
+      return ((index < my_mag.size()) && (((my_mag[index] >> (bit % 32U)) & 1U) != 0U));
+    }
+
+    auto shift_right(const ::std::size_t bits) const -> native_integer
+    {
+      // Shift the magnitude of a non-negative integer to the right.
+
+      native_integer result { };
+
+      const ::std::size_t limb_shift { bits / 32U };
+      const unsigned      bit_shift  { static_cast<unsigned>(bits % 32U) };
+
+      for(::std::size_t index { limb_shift }; index < my_mag.size(); ++index)
+      {
+        const limb_type hi { ((bit_shift != 0U) && ((index + 1U) < my_mag.size())) ? static_cast<limb_type>(my_mag[index + 1U] << (32U - bit_shift)) : limb_type { UINT8_C(0) } };
+
+        result.my_mag.push_back(static_cast<limb_type>((my_mag[index] >> bit_shift) | hi));
+      }
+
+      trim(result.my_mag);
+
+      return result;
+    }
+
+    auto trailing_zero_bits() const noexcept -> ::std::size_t
+    {
+      ::std::size_t bits { };
+
+      while((bits < bit_length()) && (!test_bit(bits)))
+      {
+        ++bits;
+      }
+
+      return bits;
+    }
+
+    static auto mul_mod(const native_integer& a, const native_integer& b, const native_integer& n) -> native_integer
+    {
+      return mod(a * b, n);
+    }
+
+    static auto pow_mod(const native_integer& base, const native_integer& exponent, const native_integer& n) -> native_integer
+    {
+      native_integer result { INT64_C(1) };
+
+      for(::std::size_t bit { exponent.bit_length() }; bit > ::std::size_t { UINT8_C(0) }; --bit)
+      {
+        result = mul_mod(result, result, n);
+
+        if(exponent.test_bit(bit - 1U))
+        {
+          result = mul_mod(result, base, n);
+        }
+      }
+
+      return mod(result, n);
+    }
+
+    static auto jacobi(native_integer a, native_integer n) -> int
+    {
+      // Compute the Jacobi symbol (a/n) for odd, positive n.
+
+      a = mod(a, n);
+
+      int result { 1 };
+
+      while(!a.is_zero())
+      {
+        while(!a.is_odd())
+        {
+          a = a.shift_right(1U);
+
+          const limb_type r { static_cast<limb_type>(n.my_mag.front() % 8U) };
+
+          if((r == limb_type { UINT8_C(3) }) || (r == limb_type { UINT8_C(5) }))
+          {
+            result = -result;
+          }
+        }
+
+        ::std::swap(a, n);
+
+        if(((a.my_mag.front() % 4U) == 3U) && ((n.my_mag.front() % 4U) == 3U))
+        {
+          result = -result;
+        }
+
+        a = mod(a, n);
+      }
+
+      return ((n == native_integer { INT64_C(1) }) ? result : 0);
+    }
+
+    auto is_square() const -> bool
+    {
+      // Use Newton iteration for the integer square root.
+
+      if(compare(*this, native_integer { INT64_C(2) }) < 0)
+      {
+        return true;
+      }
+
+      native_integer x { INT64_C(1) };
+
+      x.my_mag.insert(x.my_mag.begin(), ((bit_length() + 1U) / 2U) / 32U, limb_type { UINT8_C(0) });
+
+      x.my_mag.back() = static_cast<limb_type>(limb_type { UINT8_C(1) } << (((bit_length() + 1U) / 2U) % 32U));
+
+      for(;;)
+      {
+        native_integer quo { };
+
+        static_cast<void>(divmod_floor(*this, x, &quo, nullptr));
+
+        const native_integer y { (x + quo).shift_right(1U) };
+
+        if(compare(y, x) >= 0)
+        {
+          break;
+        }
+
+        x = y;
+      }
+
+      return ((x * x) == *this);
+    }
+
+    auto is_strong_probable_prime_base_2() const -> bool
+    {
+      const native_integer n_minus_one { *this - native_integer { INT64_C(1) } };
+
+      const ::std::size_t s { n_minus_one.trailing_zero_bits() };
+
+      native_integer x { pow_mod(native_integer { INT64_C(2) }, n_minus_one.shift_right(s), *this) };
+
+      if((x == native_integer { INT64_C(1) }) || (x == n_minus_one))
+      {
+        return true;
+      }
+
+      for(::std::size_t r { UINT8_C(1) }; r < s; ++r)
+      {
+        x = mul_mod(x, x, *this);
+
+        if(x == n_minus_one)
+        {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    auto half_mod(native_integer x) const -> native_integer
+    {
+      // Compute x / 2 modulo this odd modulus.
+
+      x = mod(x, *this);
+
+      if(x.is_odd())
+      {
+        x = x + *this;
+      }
+
+      return x.shift_right(1U);
+    }
+
+    auto is_strong_lucas_probable_prime() const -> bool
+    {
+      // Choose D as the first of 5, -7, 9, -11, ... with (D/n) = -1.
+      // A perfect square has no such D, so these are excluded first.
+
+      if(is_square())
+      {
+        return false;
+      }
+
+      native_integer d { INT64_C(5) };
+
+      for(;;)
+      {
+        const int jac { jacobi(d, *this) };
+
+        if(jac == -1)
+        {
+          break;
+        }
+
+        if((jac == 0) && (d.abs() != *this))
+        {
+          return false;
+        }
+
+        d = ((d.is_negative()) ? (native_integer { INT64_C(2) } - d) : (-(d + native_integer { INT64_C(2) })));
+      }
+
+      const native_integer p { INT64_C(1) };
+
+      native_integer q { };
+
+      static_cast<void>(divmod_floor(native_integer { INT64_C(1) } - d, native_integer { INT64_C(4) }, &q, nullptr));
+
+      const native_integer n_plus_one { *this + native_integer { INT64_C(1) } };
+
+      const ::std::size_t s { n_plus_one.trailing_zero_bits() };
+
+      const native_integer k { n_plus_one.shift_right(s) };
+
+      native_integer u  { INT64_C(1) };
+      native_integer v  { p };
+      native_integer qk { mod(q, *this) };
+
+      const native_integer two { INT64_C(2) };
+
+      for(::std::size_t bit { k.bit_length() - 1U }; bit > ::std::size_t { UINT8_C(0) }; --bit)
+      {
+        // Double the index.
+        u  = mul_mod(u, v, *this);
+        v  = mod((v * v) - (two * qk), *this);
+        qk = mul_mod(qk, qk, *this);
+
+        if(k.test_bit(bit - 1U))
+        {
+          // Increment the index.
+          const native_integer u_next { half_mod((p * u) + v) };
+          const native_integer v_next { half_mod((d * u) + (p * v)) };
+
+          u  = u_next;
+          v  = v_next;
+          qk = mul_mod(qk, q, *this);
+        }
+      }
+
+      if(u.is_zero() || v.is_zero())
+      {
+        return true;
+      }
+
+      for(::std::size_t r { UINT8_C(1) }; r < s; ++r)
+      {
+        v  = mod((v * v) - (two * qk), *this);
+        qk = mul_mod(qk, qk, *this);
+
+        if(v.is_zero())
+        {
+          return true;
+        }
+      }
+
+      return false;
+    }
+  };
+
+  } } // namespace mathematica::detail
+
+#endif // MATHEMATICA_NATIVE_INTEGER_2026_10_16_H
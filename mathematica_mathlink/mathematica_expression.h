@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_EXPRESSION_2026_10_16_H
+  #define MATHEMATICA_EXPRESSION_2026_10_16_H
+
+  #include <algorithm>
+  #include <cstddef>
+  #include <cstdint>
+  #include <iterator>
+  #include <limits>
+  #include <string>
+  #include <type_traits>
+  #include <utility>
+  #include <vector>
+
+  namespace mathematica {
+
+  enum class expression_token_kind
+  {
+    function,
+    integer,
+    integer_digits,
+    integer_limbs,
+    string,
+    symbol
+  };
+
+  struct expression_token
+  {
+    // For a function, the value is the argument count and the string is the head.
+    // For an integer, the value is the integer itself.
+    // For integer digits, the string holds the decimal digits of the integer.
+    // For integer limbs, the list holds the base-2^32 digits of the integer,
+    // with the most significant digit first.
+    // For a string or a symbol, the string holds the string or symbol name.
+
+    expression_token_kind         kind  { expression_token_kind::integer };
+    ::std::int64_t                value { };
+    ::std::string                 str   { };
+    ::std::vector<::std::int64_t> list  { };
+  };
+
+  class expression
+  {
+  public:
+    // This is the expression class. It builds up an expression such as
+    // PrimeQ[123] or GCD[12, 18] or First[QuotientRemainder[a, b]]
+    // with typed arguments. The link puts the expression directly with
+    // WSPutFunction(), WSPutInteger64(), WSPutString(), etc. This avoids
+    // string concatenation on the client side and ToExpression parsing
+    // on the kernel side.
+
+    // The expression is held as a flat list of tokens in prefix order,
+    // which is exactly the order in which the tokens are put on the link.
+
+    using token_type      = expression_token;
+    using token_list_type = ::std::vector<token_type>;
+
+    explicit expression(::std::string str_head)
+      : my_tokens { token_type { expression_token_kind::function, ::std::int64_t { INT8_C(0) }, ::std::move(str_head) } } { }
+
+    template<typename IntegralType,
+             typename ::std::enable_if<(   ::std::is_integral<IntegralType>::value
+                                        && (!::std::is_same<IntegralType, bool>::value))>::type const* = nullptr>
+    auto arg(const IntegralType n) -> expression&
+    {
+      // An unsigned value beyond the range of int64 is put by its decimal digits.
+      // Integers wider than 64 bits are put with arg_limbs() or arg_integer().
+
+      static_assert(::std::numeric_limits<IntegralType>::digits <= 64,
+                    "Error: The integral type must not be wider than 64 bits, use arg_limbs() or arg_integer()");
+
+      return (fits_int64(n) ? append(token_type { expression_token_kind::integer, static_cast<::std::int64_t>(n), ::std::string { } })
+                            : arg_integer(::std::to_string(static_cast<unsigned long long>(n))));
+    }
+
+    auto arg(const char* p_str) -> expression&
+    {
+      return append(token_type { expression_token_kind::string, ::std::int64_t { INT8_C(0) }, ::std::string { p_str } });
+    }
+
+    auto arg(::std::string str) -> expression&
+    {
+      return append(token_type { expression_token_kind::string, ::std::int64_t { INT8_C(0) }, ::std::move(str) });
+    }
+
+    auto arg(const expression& sub) -> expression&
+    {
+      ++my_tokens.front().value;
+
+      my_tokens.insert(my_tokens.end(), sub.my_tokens.cbegin(), sub.my_tokens.cend());
+
+      return *this;
+    }
+
+    auto arg_symbol(::std::string str_symbol) -> expression&
+    {
+      return append(token_type { expression_token_kind::symbol, ::std::int64_t { INT8_C(0) }, ::std::move(str_symbol) });
+    }
+
+    auto arg_integer(::std::string str_digits) -> expression&
+    {
+      // Add an integer of arbitrary size given by its decimal digits,
+      // with an optional leading minus sign. This is put on the link as
+      // an integer token, not as a string that needs to be parsed.
+
+      return append(token_type { expression_token_kind::integer_digits, ::std::int64_t { INT8_C(0) }, ::std::move(str_digits) });
+    }
+
+    template<typename InputIterator>
+    auto arg_limbs(InputIterator first, InputIterator last) -> expression&
+    {
+      // Add an unsigned integer of arbitrary size given by its limbs, with
+      // the least significant limb first. This is the in-memory layout of
+      // most multiple-precision types. The integer is sent in binary form
+      // as a list of base-2^32 digits, which the kernel reassembles with
+      // FromDigits. This avoids decimal conversion on both sides.
+
+      using limb_type = typename ::std::iterator_traits<InputIterator>::value_type;
+
+      static_assert(   ::std::is_unsigned<limb_type>::value
+                    && (   (::std::numeric_limits<limb_type>::digits == 8)
+                        || (::std::numeric_limits<limb_type>::digits == 16)
+                        || (::std::numeric_limits<limb_type>::digits == 32)
+                        || (::std::numeric_limits<limb_type>::digits == 64)),
+                    "Error: The limb type must be an unsigned integral type of 8, 16, 32 or 64 bits");
+
+      constexpr unsigned limb_bits { static_cast<unsigned>(::std::numeric_limits<limb_type>::digits) };
+
+      ::std::vector<::std::int64_t> digits { };
+
+      ::std::uint64_t accumulator      { };
+      unsigned        accumulator_bits { };
+
+      for( ; first != last; ++first)
+      {
+        const ::std::uint64_t limb { static_cast<::std::uint64_t>(*first) };
+
+        if(limb_bits < unsigned { UINT8_C(32) })
+        {
+          accumulator |= static_cast<::std::uint64_t>(limb << accumulator_bits);
+
+          accumulator_bits += limb_bits;
+
+          if(accumulator_bits == unsigned { UINT8_C(32) })
+          {
+            digits.push_back(static_cast<::std::int64_t>(accumulator));
+
+            accumulator      = ::std::uint64_t { UINT8_C(0) };
+            accumulator_bits = unsigned { UINT8_C(0) };
+          }
+        }
+        else
+        {
+          for(unsigned shift { UINT8_C(0) }; shift < limb_bits; shift += unsigned { UINT8_C(32) })
+          {
+            digits.push_back(static_cast<::std::int64_t>(static_cast<::std::uint32_t>(limb >> shift)));
+          }
+        }
+      }
+
+      if(accumulator_bits != unsigned { UINT8_C(0) })
+      {
+        digits.push_back(static_cast<::std::int64_t>(accumulator));
+      }
+
+      // Remove the leading zeros and put the most significant digit first.
+      while((!digits.empty()) && (digits.back() == ::std::int64_t { INT8_C(0) }))
+      {
+        digits.pop_back();
+      }
+
+      ::std::reverse(digits.begin(), digits.end());
+
+      token_type tok { expression_token_kind::integer_limbs, ::std::int64_t { INT8_C(0) }, ::std::string { }, ::std::move(digits) };
+
+      return append(::std::move(tok));
+    }
+
+    static constexpr auto limbs_radix() noexcept -> ::std::int64_t { return ::std::int64_t { INT64_C(0x100000000) }; }
+
+    auto tokens() const noexcept -> const token_list_type& { return my_tokens; }
+
+  private:
+    token_list_type my_tokens;
+
+    template<typename IntegralType>
+    static constexpr auto fits_int64(const IntegralType n) noexcept -> bool
+    {
+      return
+      (
+           (!::std::is_unsigned<IntegralType>::value)
+        || (::std::numeric_limits<IntegralType>::digits < 64)
+        || (static_cast<::std::uint64_t>(n) <= static_cast<::std::uint64_t>((::std::numeric_limits<::std::int64_t>::max)()))
+      );
+    }
+
+    auto append(token_type tok) -> expression&
+    {
+      ++my_tokens.front().value;
+
+      my_tokens.push_back(::std::move(tok));
+
+      return *this;
+    }
+  };
+
+  inline auto head(::std::string str_head) -> expression
+  {
+    return expression { ::std::move(str_head) };
+  }
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_EXPRESSION_2026_10_16_H
@@ -0,0 +1,385 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_KERNEL_LOCATOR_2026_10_16_H
+  #define MATHEMATICA_KERNEL_LOCATOR_2026_10_16_H
+
+  #include <algorithm>
+  #include <array>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstdio>
+  #include <cstdlib>
+  #include <fstream>
+  #include <mutex>
+  #include <string>
+  #include <vector>
+
+  #if !defined(_WIN32)
+  #include <dirent.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #endif
+
+  namespace mathematica {
+
+  class kernel_locator
+  {
+  public:
+    // This is the kernel_locator class. It finds the kernel to be launched
+    // and provides the string used for the link name. The kernel is searched
+    // for in the following order:
+
+    //   1. The environment variable MATHEMATICA_MATHLINK_KERNEL, which holds
+    //      the complete link name (such as "/path/to/math -mathlink").
+    //   2. The kernel location given by the caller, if any.
+    //   3. The cached result of a previous search, held in a small state file.
+    //   4. WolframKernel, math or MathKernel in the directories of $PATH.
+    //   5. The usual installation prefixes, with the latest version first.
+
+    // This is the only place where MATHEMATICA_MATHLINK_KERNEL is read. It
+    // names a kernel to launch. The name of a link to connect to or to listen
+    // on is given in MATHEMATICA_MATHLINK_LINKNAME instead (see the options).
+
+    // The result of a search is written to the state file, so that subsequent
+    // processes start without searching. A cached kernel that no longer exists
+    // is searched for anew. The state file is $MATHEMATICA_MATHLINK_KERNEL_CACHE,
+    // or else $XDG_CACHE_HOME/mathematica_mathlink_kernel, or else
+    // $HOME/.cache/mathematica_mathlink_kernel.
+
+    // The search is done once per process. If no kernel is found, the link name
+    // is empty, and the link fails to open at once instead of waiting on a launch
+    // that can not succeed.
+
+    // On Win*, only the environment override is supported. Otherwise
+    // the default installation location of the kernel is used.
+
+    static auto link_name(const char* p_str_location = nullptr) -> ::std::string
+    {
+      const ::std::string str_override { str_environment("MATHEMATICA_MATHLINK_KERNEL") };
+
+      if(!str_override.empty())
+      {
+        return str_override;
+      }
+
+      if(p_str_location != nullptr)
+      {
+        return ::std::string { p_str_location };
+      }
+
+      static ::std::once_flag once { };
+      static ::std::string    str_name { };
+
+      ::std::call_once(once, []() { str_name = find_link_name(); });
+
+      return str_name;
+    }
+
+    static auto link_name_of_kernel(const ::std::string& str_kernel) -> ::std::string
+    {
+      // The kernel is launched in WSTP (MathLink) mode. Paths
+      // that contain spaces are quoted.
+
+      const bool has_space { (str_kernel.find(' ') != ::std::string::npos) };
+
+      const ::std::string str_path { has_space ? ("\"" + str_kernel + "\"") : str_kernel };
+
+      #if defined(_WIN32)
+      return str_path;
+      #else
+      return str_path + " -mathlink";
+      #endif
+    }
+
+    static auto str_environment(const char* p_str_name) -> ::std::string
+    {
+      const char* p_str_value { ::std::getenv(p_str_name) }; // NOLINT(concurrency-mt-unsafe)
+
+      return ((p_str_value == nullptr) ? ::std::string { } : ::std::string { p_str_value });
+    }
+
+    static auto str_cache_path() -> ::std::string
+    {
+      const ::std::string str_cache { str_environment("MATHEMATICA_MATHLINK_KERNEL_CACHE") };
+
+      if(!str_cache.empty())
+      {
+        return str_cache;
+      }
+
+      const ::std::string str_xdg { str_environment("XDG_CACHE_HOME") };
+
+      if(!str_xdg.empty())
+      {
+        return str_xdg + "/mathematica_mathlink_kernel";
+      }
+
+      const ::std::string str_home { str_environment("HOME") };
+
+      return (str_home.empty() ? ::std::string { } : (str_home + "/.cache/mathematica_mathlink_kernel"));
+    }
+
+    #if !defined(_WIN32)
+    static auto is_executable(const ::std::string& str_path) -> bool
+    {
+      struct stat st { };
+
+      return (   (::stat(str_path.c_str(), &st) == 0)
+              && S_ISREG(st.st_mode)
+              && (::access(str_path.c_str(), X_OK) == 0));
+    }
+
+    static auto find_in_path(::std::string* p_str_kernel) -> bool
+    {
+      const ::std::string str_path { str_environment("PATH") };
+
+      ::std::string::size_type pos { };
+
+      while(pos <= str_path.size())
+      {
+        const ::std::string::size_type pos_next { ::std::min(str_path.find(':', pos), str_path.size()) };
+
+        const ::std::string str_dir { str_path.substr(pos, pos_next - pos) };
+
+        if((!str_dir.empty()) && find_in_directory(str_dir, p_str_kernel))
+        {
+          return true;
+        }
+
+        pos = pos_next + ::std::string::size_type { UINT8_C(1) };
+      }
+
+      return false;
+    }
+
+    static auto find_in_prefixes(::std::string* p_str_kernel) -> bool
+    {
+      // Within each prefix, the version directories are tried
+      // from the latest version down to the oldest one.
+
+      using prefix_array_type = ::std::array<const char*, ::std::size_t { UINT8_C(5) }>;
+
+      constexpr prefix_array_type
+        prefixes
+        {
+          "/usr/local/Wolfram/Wolfram",
+          "/usr/local/Wolfram/Mathematica",
+          "/usr/local/Wolfram/WolframEngine",
+          "/opt/Wolfram/Mathematica",
+          "/opt/Wolfram/WolframEngine"
+        };
+
+      for(const char* p_str_prefix : prefixes)
+      {
+        ::std::vector<::std::string> versions { subdirectories(p_str_prefix) };
+
+        ::std::sort(versions.begin(), versions.end(), version_is_later);
+
+        for(const ::std::string& str_version : versions)
+        {
+          if(find_in_directory(::std::string(p_str_prefix) + "/" + str_version + "/Executables", p_str_kernel))
+          {
+            return true;
+          }
+        }
+      }
+
+      using bundle_array_type = ::std::array<const char*, ::std::size_t { UINT8_C(2) }>;
+
+      constexpr bundle_array_type
+        bundles
+        {
+          "/Applications/Wolfram.app/Contents/MacOS",
+          "/Applications/Mathematica.app/Contents/MacOS"
+        };
+
+      for(const char* p_str_bundle : bundles)
+      {
+        if(find_in_directory(p_str_bundle, p_str_kernel))
+        {
+          return true;
+        }
+      }
+
+      return false;
+    }
+    #endif
+
+  private:
+    static auto find_link_name() -> ::std::string
+    {
+      #if defined(_WIN32)
+      return link_name_of_kernel("C:\\Program Files\\Wolfram Research\\Mathematica\\14.0\\MathKernel.exe");
+      #else
+      const ::std::string str_cache_file { str_cache_path() };
+
+      ::std::string str_kernel { };
+
+      if(read_cache(str_cache_file, &str_kernel))
+      {
+        return link_name_of_kernel(str_kernel);
+      }
+
+      if(find_in_path(&str_kernel) || find_in_prefixes(&str_kernel))
+      {
+        write_cache(str_cache_file, str_kernel);
+
+        return link_name_of_kernel(str_kernel);
+      }
+
+      return ::std::string { };
+      #endif
+    }
+
+    #if !defined(_WIN32)
+    static auto find_in_directory(const ::std::string& str_dir, ::std::string* p_str_kernel) -> bool
+    {
+      using name_array_type = ::std::array<const char*, ::std::size_t { UINT8_C(3) }>;
+
+      constexpr name_array_type names { "WolframKernel", "math", "MathKernel" };
+
+      for(const char* p_str_name : names)
+      {
+        const ::std::string str_candidate { str_dir + "/" + p_str_name };
+
+        if(is_executable(str_candidate))
+        {
+          *p_str_kernel = str_candidate;
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    static auto subdirectories(const char* p_str_dir) -> ::std::vector<::std::string>
+    {
+      ::std::vector<::std::string> names { };
+
+      DIR* p_dir { ::opendir(p_str_dir) };
+
+      if(p_dir != nullptr)
+      {
+        for(const dirent* p_entry { ::readdir(p_dir) }; p_entry != nullptr; p_entry = ::readdir(p_dir))
+        {
+          const ::std::string str_name { static_cast<const char*>(p_entry->d_name) };
+
+          if((!str_name.empty()) && (str_name.front() != '.'))
+          {
+            names.push_back(str_name);
+          }
+        }
+
+        static_cast<void>(::closedir(p_dir));
+      }
+
+      return names;
+    }
+
+    static auto version_is_later(const ::std::string& str_a, const ::std::string& str_b) -> bool
+    {
+      // Compare version strings like 14.0 and 12.1 numerically, part by part.
+
+      ::std::string::size_type pos_a { };
+      ::std::string::size_type pos_b { };
+
+      while((pos_a < str_a.size()) || (pos_b < str_b.size()))
+      {
+        const unsigned long part_a { version_part(str_a, &pos_a) };
+        const unsigned long part_b { version_part(str_b, &pos_b) };
+
+        if(part_a != part_b)
+        {
+          return (part_a > part_b);
+        }
+      }
+
+      return (str_a > str_b);
+    }
+
+    static auto version_part(const ::std::string& str, ::std::string::size_type* p_pos) -> unsigned long
+    {
+      unsigned long part { };
+
+      while((*p_pos < str.size()) && (str[*p_pos] >= '0') && (str[*p_pos] <= '9'))
+      {
+        part = static_cast<unsigned long>((part * 10UL) + static_cast<unsigned long>(str[*p_pos] - '0'));
+
+        ++(*p_pos);
+      }
+
+      // Skip the separator (or any other character).
+      if(*p_pos < str.size())
+      {
+        ++(*p_pos);
+      }
+
+      return part;
+    }
+
+    static auto read_cache(const ::std::string& str_cache_file, ::std::string* p_str_kernel) -> bool
+    {
+      if(str_cache_file.empty())
+      {
+        return false;
+      }
+
+      ::std::ifstream in_file { str_cache_file };
+
+      ::std::string str_kernel { };
+
+      const bool result_read_is_ok { static_cast<bool>(::std::getline(in_file, str_kernel)) };
+
+      if(result_read_is_ok && is_executable(str_kernel))
+      {
+        *p_str_kernel = str_kernel;
+
+        return true;
+      }
+
+      return false;
+    }
+
+    static auto write_cache(const ::std::string& str_cache_file, const ::std::string& str_kernel) -> void
+    {
+      if(str_cache_file.empty())
+      {
+        return;
+      }
+
+      // Create the directory of the state file, if needed. Then write the file
+      // under a temporary name and rename it, so that concurrent readers never
+      // see a partially written state file.
+
+      const ::std::string::size_type pos_slash { str_cache_file.rfind('/') };
+
+      if((pos_slash != ::std::string::npos) && (pos_slash != ::std::string::size_type { UINT8_C(0) }))
+      {
+        static_cast<void>(::mkdir(str_cache_file.substr(::std::string::size_type { UINT8_C(0) }, pos_slash).c_str(), 0755));
+      }
+
+      const ::std::string str_temp_file { str_cache_file + "." + ::std::to_string(::getpid()) };
+
+      {
+        ::std::ofstream out_file { str_temp_file, ::std::ios::out | ::std::ios::trunc };
+
+        out_file << str_kernel << '\n';
+      }
+
+      if(::std::rename(str_temp_file.c_str(), str_cache_file.c_str()) != 0)
+      {
+        static_cast<void>(::std::remove(str_temp_file.c_str()));
+      }
+    }
+    #endif
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_KERNEL_LOCATOR_2026_10_16_H
@@ -0,0 +1,268 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_LINK_POOL_2026_10_16_H
+  #define MATHEMATICA_LINK_POOL_2026_10_16_H
+
+  #include <mathematica_mathlink/mathematica_mathlink.h>
+
+  #include <atomic>
+  #include <condition_variable>
+  #include <cstddef>
+  #include <cstdint>
+  #include <deque>
+  #include <functional>
+  #include <future>
+  #include <memory>
+  #include <mutex>
+  #include <string>
+  #include <thread>
+  #include <vector>
+
+  namespace mathematica {
+
+  template<const char* PtrStrLocationMathLinkKernel = nullptr>
+  class mathematica_link_pool : public mathematica_mathlink_base
+  {
+  public:
+    // This is the mathematica_link_pool class.
+    // It launches several kernels, each one having its own link,
+    // and it spreads the commands across these kernels.
+
+    // There is one worker thread per kernel. Each worker has its own
+    // queue of commands. Commands are distributed round-robin among the
+    // queues. A worker whose own queue is empty steals commands from
+    // the back of the other queues, so that no kernel sits idle while
+    // there is still work to do.
+
+    using link_type = mathematica_mathlink<PtrStrLocationMathLinkKernel>;
+
+    explicit mathematica_link_pool(const ::std::size_t number_of_kernels)
+      : my_links  (number_of_kernels),
+        my_queues (number_of_kernels)
+    {
+      for(auto& lnk : my_links)
+      {
+        lnk.reset(new link_type { });
+      }
+
+      my_workers.reserve(number_of_kernels);
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < number_of_kernels; ++index)
+      {
+        my_workers.emplace_back([this, index]() { worker_loop(index); });
+      }
+    }
+
+    ~mathematica_link_pool() noexcept override
+    {
+      {
+        const ::std::lock_guard<::std::mutex> lock { my_wait_mutex };
+
+        my_stop = true;
+      }
+
+      my_wait_cond.notify_all();
+
+      for(auto& worker : my_workers)
+      {
+        worker.join();
+      }
+    }
+
+    auto size() const noexcept -> ::std::size_t { return my_links.size(); }
+
+    auto send_command(const ::std::string& str_cmd, ::std::string* str_rsp) const -> bool override
+    {
+      return send_command_async(str_cmd, str_rsp).get();
+    }
+
+    auto send_command_async(const ::std::string& str_cmd, ::std::string* str_rsp) const -> ::std::future<bool>
+    {
+      // The caller must keep the response string alive
+      // until the returned future is ready.
+
+      return
+        submit
+        (
+          [str_cmd, str_rsp](const link_type& lnk) -> bool
+          {
+            return lnk.send_command(str_cmd, str_rsp);
+          }
+        );
+    }
+
+    auto send_batch(const ::std::vector<::std::string>& str_cmds, ::std::vector<::std::string>* str_rsps) const -> bool
+    {
+      // Spread the commands of the batch across all of the kernels
+      // and wait for all of them. The responses are stored in the
+      // order of the commands.
+
+      const bool suppress_output { str_rsps == nullptr };
+
+      if(!suppress_output)
+      {
+        str_rsps->resize(str_cmds.size());
+      }
+
+      ::std::vector<::std::future<bool>> ftrs { };
+
+      ftrs.reserve(str_cmds.size());
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < str_cmds.size(); ++index)
+      {
+        ftrs.push_back(send_command_async(str_cmds[index], (suppress_output ? nullptr : &(*str_rsps)[index])));
+      }
+
+      bool result_batch_is_ok { true };
+
+      for(auto& ftr : ftrs)
+      {
+        result_batch_is_ok = (ftr.get() && result_batch_is_ok);
+      }
+
+      return result_batch_is_ok;
+    }
+
+  private:
+    struct request_type
+    {
+      ::std::function<bool(const link_type&)> task   { };
+      ::std::promise<bool>                    result { };
+    };
+
+    struct queue_type
+    {
+      ::std::mutex               mtx      { };
+      ::std::deque<request_type> requests { };
+    };
+
+    ::std::vector<::std::unique_ptr<link_type>> my_links;
+
+    mutable ::std::vector<queue_type>    my_queues;
+    mutable ::std::mutex                 my_wait_mutex { };
+    mutable ::std::condition_variable    my_wait_cond  { };
+    mutable ::std::size_t                my_pending    { };
+    mutable ::std::atomic<::std::size_t> my_next       { };
+    bool                                 my_stop       { false };
+
+    ::std::vector<::std::thread> my_workers { };
+
+    auto get_valid() const noexcept -> bool override
+    {
+      bool result_is_valid { !my_links.empty() };
+
+      for(const auto& lnk : my_links)
+      {
+        result_is_valid = (lnk->is_valid() && result_is_valid);
+      }
+
+      return result_is_valid;
+    }
+
+    auto get_traffic() const -> mathematica_mathlink_traffic override
+    {
+      mathematica_mathlink_traffic result { };
+
+      for(const auto& lnk : my_links)
+      {
+        result += lnk->traffic();
+      }
+
+      return result;
+    }
+
+    auto submit(::std::function<bool(const link_type&)> task) const -> ::std::future<bool>
+    {
+      request_type req { ::std::move(task), ::std::promise<bool> { } };
+
+      ::std::future<bool> ftr { req.result.get_future() };
+
+      queue_type& que { my_queues[my_next++ % my_queues.size()] };
+
+      {
+        const ::std::lock_guard<::std::mutex> lock { que.mtx };
+
+        que.requests.push_back(::std::move(req));
+      }
+
+      {
+        const ::std::lock_guard<::std::mutex> lock { my_wait_mutex };
+
+        ++my_pending;
+      }
+
+      my_wait_cond.notify_one();
+
+      return ftr;
+    }
+
+    auto try_pop(const ::std::size_t index, request_type* p_req) const -> bool
+    {
+      // Take work from the front of our own queue first.
+      // Otherwise steal work from the back of another queue.
+
+      for(::std::size_t count { ::std::size_t { UINT8_C(0) } }; count < my_queues.size(); ++count)
+      {
+        queue_type& que { my_queues[(index + count) % my_queues.size()] };
+
+        const ::std::lock_guard<::std::mutex> lock { que.mtx };
+
+        if(!que.requests.empty())
+        {
+          if(count == ::std::size_t { UINT8_C(0) })
+          {
+            *p_req = ::std::move(que.requests.front());
+
+            que.requests.pop_front();
+          }
+          else
+          {
+            *p_req = ::std::move(que.requests.back());
+
+            que.requests.pop_back();
+          }
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    auto worker_loop(const ::std::size_t index) const -> void
+    {
+      const link_type& lnk { *my_links[index] };
+
+      for(;;)
+      {
+        {
+          ::std::unique_lock<::std::mutex> lock { my_wait_mutex };
+
+          my_wait_cond.wait(lock, [this]() { return (my_stop || (my_pending != ::std::size_t { UINT8_C(0) })); });
+
+          if(my_pending == ::std::size_t { UINT8_C(0) })
+          {
+            break;
+          }
+
+          --my_pending;
+        }
+
+        request_type req { };
+
+        if(try_pop(index, &req))
+        {
+          req.result.set_value(req.task(lnk));
+        }
+      }
+    }
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_LINK_POOL_2026_10_16_H
@@ -0,0 +1,396 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_LINK_REACTOR_2026_10_16_H
+  #define MATHEMATICA_LINK_REACTOR_2026_10_16_H
+
+  #include <mathematica_mathlink/mathematica_mathlink.h>
+
+  #include <algorithm>
+  #include <atomic>
+  #include <chrono>
+  #include <condition_variable>
+  #include <cstddef>
+  #include <cstdint>
+  #include <deque>
+  #include <future>
+  #include <memory>
+  #include <mutex>
+  #include <string>
+  #include <thread>
+  #include <utility>
+  #include <vector>
+
+  namespace mathematica {
+
+  template<const char* PtrStrLocationMathLinkKernel = nullptr>
+  class mathematica_link_reactor : public mathematica_mathlink_base
+  {
+  public:
+    // This is the mathematica_link_reactor class. It launches several
+    // kernels, each one having its own link, and it drives all of them
+    // from one single reactor thread (rather than one thread per kernel,
+    // as in mathematica_link_pool).
+
+    // Commands are pushed onto a lock-free submission queue. The reactor
+    // thread posts each command to the live link having the fewest commands
+    // in flight, keeping up to a given depth of commands in flight per kernel.
+    // It then polls the links for readiness and completes each command as
+    // soon as its response has arrived. While nothing is ready, the reactor
+    // yields, and then backs off for a few tens of microseconds at most, so
+    // that a completion is noticed promptly. While nothing is in flight, it sleeps.
+
+    using link_type = mathematica_mathlink<PtrStrLocationMathLinkKernel>;
+
+    explicit mathematica_link_reactor(const ::std::size_t number_of_kernels,
+                                      const ::std::size_t depth_per_kernel = ::std::size_t { UINT8_C(2) })
+      : my_links          (number_of_kernels),
+        my_in_flight      (number_of_kernels),
+        my_link_is_dead   (number_of_kernels),
+        my_depth_per_link { (::std::max)(depth_per_kernel, ::std::size_t { UINT8_C(1) }) }
+    {
+      for(auto& lnk : my_links)
+      {
+        lnk.reset(new link_type { });
+      }
+
+      my_thread = ::std::thread { [this]() { reactor_loop(); } };
+    }
+
+    ~mathematica_link_reactor() noexcept override
+    {
+      // The commands that have already been submitted are completed before leaving.
+
+      {
+        const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+        my_stop = true;
+      }
+
+      my_cond.notify_one();
+
+      my_thread.join();
+    }
+
+    auto size() const noexcept -> ::std::size_t { return my_links.size(); }
+
+    auto send_command(const ::std::string& str_cmd, ::std::string* str_rsp) const -> bool override
+    {
+      return send_command_async(str_cmd, str_rsp).get();
+    }
+
+    auto send_command_async(const ::std::string& str_cmd, ::std::string* str_rsp) const -> ::std::future<bool>
+    {
+      // The caller must keep the response string alive
+      // until the returned future is ready.
+
+      request_type req { str_cmd, str_rsp, ::std::promise<bool> { } };
+
+      ::std::future<bool> ftr { req.result.get_future() };
+
+      my_queue.push(::std::move(req));
+
+      // As for the link I/O thread, the mutex is only needed
+      // when the reactor thread is going to sleep.
+      ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+
+      if(my_sleeping.load(::std::memory_order_relaxed))
+      {
+        {
+          const ::std::lock_guard<::std::mutex> lock { my_mutex };
+        }
+
+        my_cond.notify_one();
+      }
+
+      return ftr;
+    }
+
+    auto send_batch(const ::std::vector<::std::string>& str_cmds, ::std::vector<::std::string>* str_rsps) const -> bool
+    {
+      // Spread the commands of the batch across all of the kernels
+      // and wait for all of them. The responses are stored in the
+      // order of the commands.
+
+      const bool suppress_output { str_rsps == nullptr };
+
+      if(!suppress_output)
+      {
+        str_rsps->resize(str_cmds.size());
+      }
+
+      ::std::vector<::std::future<bool>> ftrs { };
+
+      ftrs.reserve(str_cmds.size());
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < str_cmds.size(); ++index)
+      {
+        ftrs.push_back(send_command_async(str_cmds[index], (suppress_output ? nullptr : &(*str_rsps)[index])));
+      }
+
+      bool result_batch_is_ok { true };
+
+      for(auto& ftr : ftrs)
+      {
+        result_batch_is_ok = (ftr.get() && result_batch_is_ok);
+      }
+
+      return result_batch_is_ok;
+    }
+
+  private:
+    struct request_type
+    {
+      ::std::string        str_cmd { };
+      ::std::string*       str_rsp { nullptr };
+      ::std::promise<bool> result  { };
+    };
+
+    using request_list_type = ::std::deque<request_type>;
+
+    ::std::vector<::std::unique_ptr<link_type>> my_links;
+
+    // These are owned by the reactor thread.
+    mutable ::std::vector<request_list_type> my_in_flight;
+    mutable request_list_type                my_waiting   { };
+    mutable ::std::size_t                    my_count_in_flight { };
+    mutable ::std::vector<bool>              my_link_is_dead;
+
+    const ::std::size_t my_depth_per_link;
+
+    mutable detail::mpsc_queue<request_type> my_queue    { };
+    mutable ::std::mutex                     my_mutex    { };
+    mutable ::std::condition_variable        my_cond     { };
+    mutable ::std::atomic<bool>              my_sleeping { false };
+    bool                                     my_stop     { false };
+
+    ::std::thread my_thread { };
+
+    auto get_valid() const noexcept -> bool override
+    {
+      bool result_is_valid { !my_links.empty() };
+
+      for(const auto& lnk : my_links)
+      {
+        result_is_valid = (lnk->is_valid() && result_is_valid);
+      }
+
+      return result_is_valid;
+    }
+
+    auto get_traffic() const -> mathematica_mathlink_traffic override
+    {
+      mathematica_mathlink_traffic result { };
+
+      for(const auto& lnk : my_links)
+      {
+        result += lnk->traffic();
+      }
+
+      return result;
+    }
+
+    auto least_busy_live_link() const -> ::std::size_t
+    {
+      // Find the link having the fewest commands in flight among those whose
+      // kernel has not been found dead during this dispatch, or size() if none.
+
+      ::std::size_t result_index { my_links.size() };
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < my_links.size(); ++index)
+      {
+        if((!my_link_is_dead[index]) && ((result_index == my_links.size()) || (my_in_flight[index].size() < my_in_flight[result_index].size())))
+        {
+          result_index = index;
+        }
+      }
+
+      return result_index;
+    }
+
+    auto post_waiting(const ::std::size_t index) const -> bool
+    {
+      const request_type& req { my_waiting.front() };
+
+      return my_links[index]->post_command(req.str_cmd, (req.str_rsp == nullptr));
+    }
+
+    auto dispatch() const -> bool
+    {
+      // Post the waiting commands to the least busy live links that have room.
+      // A link whose kernel has died keeps no commands in flight, so it would
+      // always be the least busy one. It is skipped, and the command is posted
+      // to another link instead. A command fails when no live link is left.
+
+      bool result_progress { false };
+
+      ::std::fill(my_link_is_dead.begin(), my_link_is_dead.end(), false);
+
+      while(!my_waiting.empty())
+      {
+        const ::std::size_t index { least_busy_live_link() };
+
+        if(index == my_links.size())
+        {
+          // Without any live kernel, no command can ever succeed.
+          my_waiting.front().result.set_value(false);
+
+          my_waiting.pop_front();
+
+          result_progress = true;
+
+          continue;
+        }
+
+        if(my_in_flight[index].size() >= my_depth_per_link)
+        {
+          break;
+        }
+
+        bool result_post_is_ok { post_waiting(index) };
+
+        if(!result_post_is_ok)
+        {
+          if(!my_links[index]->is_alive())
+          {
+            my_link_is_dead[index] = true;
+
+            continue;
+          }
+
+          // The link is alive (or has just been recovered), so it takes the command once more.
+          result_post_is_ok = post_waiting(index);
+        }
+
+        request_type req { ::std::move(my_waiting.front()) };
+
+        my_waiting.pop_front();
+
+        result_progress = true;
+
+        if(result_post_is_ok)
+        {
+          my_in_flight[index].push_back(::std::move(req));
+
+          ++my_count_in_flight;
+        }
+        else
+        {
+          req.result.set_value(false);
+        }
+      }
+
+      return result_progress;
+    }
+
+    auto poll() const -> bool
+    {
+      // Complete the oldest command in flight on each link whose response has arrived.
+
+      bool result_progress { false };
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < my_links.size(); ++index)
+      {
+        request_list_type& in_flight { my_in_flight[index] };
+
+        while((!in_flight.empty()) && my_links[index]->is_ready())
+        {
+          result_progress = true;
+
+          bool is_done { false };
+
+          const bool result_recv_is_ok { my_links[index]->poll_response(in_flight.front().str_rsp, &is_done) };
+
+          if(result_recv_is_ok && (!is_done))
+          {
+            break;
+          }
+
+          in_flight.front().result.set_value(result_recv_is_ok);
+
+          in_flight.pop_front();
+
+          --my_count_in_flight;
+        }
+      }
+
+      return result_progress;
+    }
+
+    static constexpr auto yield_rounds() noexcept -> unsigned { return unsigned { UINT8_C(64) }; }
+
+    static constexpr auto backoff_min() noexcept -> ::std::chrono::microseconds { return ::std::chrono::microseconds { 5 }; }
+    static constexpr auto backoff_max() noexcept -> ::std::chrono::microseconds { return ::std::chrono::microseconds { 40 }; }
+
+    auto reactor_loop() const -> void
+    {
+      // The request is reused, since a default promise allocates its state.
+
+      unsigned                    idle_rounds { };
+      ::std::chrono::microseconds backoff     { backoff_min() };
+      request_type                req         { };
+
+      for(;;)
+      {
+        bool result_progress { false };
+
+        while(my_queue.try_pop(&req))
+        {
+          my_waiting.push_back(::std::move(req));
+
+          result_progress = true;
+        }
+
+        result_progress = (dispatch() || result_progress);
+        result_progress = (poll()     || result_progress);
+
+        if(result_progress)
+        {
+          idle_rounds = unsigned { UINT8_C(0) };
+          backoff     = backoff_min();
+        }
+        else if(my_count_in_flight != ::std::size_t { UINT8_C(0) })
+        {
+          // Some kernels are busy, but none of them is ready yet. The backoff
+          // is capped low, since it adds directly to the latency of a completion.
+          if(idle_rounds < yield_rounds())
+          {
+            ++idle_rounds;
+
+            ::std::this_thread::yield();
+          }
+          else
+          {
+            ::std::this_thread::sleep_for(backoff);
+
+            backoff = (::std::min)(backoff * 2, backoff_max());
+          }
+        }
+        else
+        {
+          ::std::unique_lock<::std::mutex> lock { my_mutex };
+
+          my_sleeping.store(true, ::std::memory_order_relaxed);
+
+          ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+
+          my_cond.wait(lock, [this]() { return (my_stop || (!my_queue.empty())); });
+
+          my_sleeping.store(false, ::std::memory_order_relaxed);
+
+          if(my_stop && my_queue.empty() && my_waiting.empty())
+          {
+            break;
+          }
+        }
+      }
+    }
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_LINK_REACTOR_2026_10_16_H
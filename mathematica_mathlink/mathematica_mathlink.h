@@ -8,14 +8,41 @@
 #ifndef MATHEMATICA_MATHLINK_2022_11_09_H
   #define MATHEMATICA_MATHLINK_2022_11_09_H
 
+  #include <mathematica_mathlink/mathematica_expression.h>
+  #include <mathematica_mathlink/mathematica_mathlink_allocations.h>
+  #include <mathematica_mathlink/mathematica_kernel_locator.h>
+  #include <mathematica_mathlink/mathematica_mathlink_latency.h>
+  #include <mathematica_mathlink/mathematica_mathlink_timeline.h>
+  #include <mathematica_mathlink/mathematica_mathlink_trace.h>
+  #include <mathematica_mathlink/mathematica_mathlink_traffic.h>
+
   #include <algorithm>
   #include <array>
+  #include <atomic>
+  #include <chrono>
+  #include <condition_variable>
   #include <cstddef>
   #include <cstdint>
+  #include <cstring>
+  #include <deque>
+  #include <functional>
+  #include <future>
+  #include <iterator>
+  #include <limits>
+  #include <mutex>
   #include <string>
+  #include <thread>
   #include <type_traits>
+  #include <utility>
   #include <vector>
 
+  #if (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)) || (defined(__cplusplus) && (__cplusplus >= 201703L))
+  #if !defined(MATHEMATICA_MATHLINK_HAS_STRING_VIEW)
+  #define MATHEMATICA_MATHLINK_HAS_STRING_VIEW
+  #endif
+  #include <string_view>
+  #endif
+
   extern "C"
   {
     using WSENV                  = struct ml_environment*;
@@ -33,17 +60,56 @@
     extern auto WSNewPacket     (WSLINK)                   -> int;
     extern auto WSPutFunction   (WSLINK, const char*, int) -> int;
     extern auto WSPutString     (WSLINK, const char*)      -> int;
+    extern auto WSPutSymbol     (WSLINK, const char*)      -> int;
+    extern auto WSPutInteger64  (WSLINK, ::std::int64_t)   -> int;
+    extern auto WSPutInteger64List(WSLINK, const ::std::int64_t*, int) -> int;
+    extern auto WSPutNext       (WSLINK, int)              -> int;
+    extern auto WSPutSize       (WSLINK, int)              -> int;
+    extern auto WSPutData       (WSLINK, const char*, int) -> int;
     extern auto WSEndPacket     (WSLINK)                   -> int;
     extern auto WSError         (WSLINK)                   -> int;
+    extern auto WSClearError    (WSLINK)                   -> int;
     extern auto WSGetString     (WSLINK, const char**)     -> int;
+    extern auto WSGetSymbol     (WSLINK, const char**)     -> int;
+    extern auto WSTestHead      (WSLINK, const char*, int*) -> int;
+    extern auto WSReleaseSymbol (WSLINK, const char*)      -> void;
+
+    extern auto WSGetInteger64         (WSLINK, ::std::int64_t*)       -> int;
+    extern auto WSGetReal64            (WSLINK, double*)               -> int;
+    extern auto WSGetInteger64List     (WSLINK, ::std::int64_t**, int*) -> int;
+    extern auto WSReleaseInteger64List (WSLINK, ::std::int64_t*, int)   -> void;
+
+    extern auto WSGetUTF8String    (WSLINK, const unsigned char**, int*, int*) -> int;
+    extern auto WSReleaseUTF8String(WSLINK, const unsigned char*, int)         -> void;
+
+    extern auto WSReady     (WSLINK)      -> int;
+    extern auto WSFlush     (WSLINK)      -> int;
+    extern auto WSPutMessage(WSLINK, int) -> int;
   }
 
   namespace mathematica {
 
   namespace detail {
 
-  // The value of RETURNPKT is 3.
-  constexpr int RETURNPKT { INT8_C(3) };
+  // The values of the packet identifiers are taken from wstp.h.
+  constexpr int TEXTPKT    { INT8_C(2) };
+  constexpr int RETURNPKT  { INT8_C(3) };
+  constexpr int MESSAGEPKT { INT8_C(5) };
+
+  // The value of the integer token type WSTKINT is 'I'.
+  constexpr int WSTKINT { static_cast<int>('I') };
+
+  // The value of the message WSAbortMessage is taken from wstp.h.
+  constexpr int WSAbortMessage { INT8_C(3) };
+
+  // The values of the error codes are taken from wstp.h.
+  constexpr int WSEOK     { INT8_C(0) };
+  constexpr int WSEDEAD   { INT8_C(1) };
+  constexpr int WSEGBAD   { INT8_C(2) };
+  constexpr int WSEGSEQ   { INT8_C(3) };
+  constexpr int WSEPSEQ   { INT8_C(5) };
+  constexpr int WSECLOSED { INT8_C(11) };
+  constexpr int WSEABORT  { INT8_C(25) };
 
   // Use a local implementation of string copy.
   template<typename DestinationIterator,
@@ -55,15 +121,6 @@
     return dst;
   }
 
-  constexpr auto strlen_unsafe(const char* p_str) -> ::std::size_t
-  {
-    ::std::size_t count { ::std::size_t { UINT8_C(0) } };
-
-    while(*p_str != '\0') { ++p_str; ++count; } // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic,altera-id-dependent-backward-branch)
-
-    return count;
-  }
-
   namespace noncopyable_hidden
   {
     struct base_token { };
@@ -89,8 +146,220 @@
 
   using noncopyable = noncopyable_hidden::noncopyable;
 
+  // All of the links in the process share one single WSTP environment.
+  // The environment is initialized when the first link is opened and it
+  // is deinitialized when the last link is closed.
+
+  struct environment_holder
+  {
+    ::std::mutex  mtx       { };
+    WSENV         env_ptr   { nullptr };
+    ::std::size_t ref_count { };
+  };
+
+  inline auto global_environment() -> environment_holder&
+  {
+    static environment_holder env_holder { };
+
+    return env_holder;
+  }
+
+  inline auto acquire_environment() -> WSENV
+  {
+    environment_holder& env_holder { global_environment() };
+
+    const ::std::lock_guard<::std::mutex> lock { env_holder.mtx };
+
+    if(env_holder.ref_count == ::std::size_t { UINT8_C(0) })
+    {
+      env_holder.env_ptr = ::WSInitialize(nullptr);
+    }
+
+    if(env_holder.env_ptr != nullptr)
+    {
+      ++env_holder.ref_count;
+    }
+
+    return env_holder.env_ptr;
+  }
+
+  inline auto release_environment() -> void
+  {
+    environment_holder& env_holder { global_environment() };
+
+    const ::std::lock_guard<::std::mutex> lock { env_holder.mtx };
+
+    if(env_holder.ref_count != ::std::size_t { UINT8_C(0) })
+    {
+      --env_holder.ref_count;
+
+      if(env_holder.ref_count == ::std::size_t { UINT8_C(0) })
+      {
+        ::WSDeinitialize(env_holder.env_ptr);
+
+        env_holder.env_ptr = nullptr;
+      }
+    }
+  }
+
+  template<typename ValueType>
+  class mpsc_queue : private noncopyable
+  {
+  public:
+    // This is a lock-free, unbounded multiple-producer single-consumer queue.
+    // It is a node-based queue following the well-known design of D. Vyukov.
+    // Any thread may push. Only one single thread may pop.
+
+    using value_type = ValueType;
+
+    mpsc_queue() : my_head { &my_stub }, my_tail { &my_stub } { }
+
+    ~mpsc_queue() override
+    {
+      value_type value { };
+
+      while(try_pop(&value)) { ; }
+
+      // The last node that has been popped remains as the tail.
+      if(my_tail != &my_stub)
+      {
+        delete my_tail;
+      }
+    }
+
+    auto push(value_type value) -> void
+    {
+      node_type* p_node { new node_type { ::std::move(value) } };
+
+      node_type* p_prev { my_head.exchange(p_node, ::std::memory_order_acq_rel) };
+
+      p_prev->next.store(p_node, ::std::memory_order_release);
+    }
+
+    auto try_pop(value_type* p_value) -> bool
+    {
+      node_type* p_tail { my_tail };
+      node_type* p_next { p_tail->next.load(::std::memory_order_acquire) };
+
+      if(p_next == nullptr)
+      {
+        return false;
+      }
+
+      *p_value = ::std::move(p_next->value);
+
+      my_tail = p_next;
+
+      if(p_tail != &my_stub)
+      {
+        delete p_tail;
+      }
+
+      return true;
+    }
+
+    auto empty() const -> bool
+    {
+      return (my_tail->next.load(::std::memory_order_acquire) == nullptr);
+    }
+
+  private:
+    struct node_type
+    {
+      explicit node_type(value_type val = value_type { }) : value { ::std::move(val) } { }
+
+      value_type               value;
+      ::std::atomic<node_type*> next { nullptr };
+    };
+
+    node_type                 my_stub { };
+    ::std::atomic<node_type*> my_head;
+    node_type*                my_tail;
+  };
+
   } // namespace detail
 
+  struct mathematica_mathlink_packet
+  {
+    // This is a single packet received from the kernel.
+    // For a MessagePacket, the string has the form symbol::tag.
+    // The text of the message itself arrives in the subsequent TextPacket.
+
+    int           id  { };
+    ::std::string str { };
+  };
+
+  using mathematica_mathlink_packet_list = ::std::vector<mathematica_mathlink_packet>;
+
+  enum class mathematica_mathlink_status
+  {
+    ok,
+    failed,
+    timeout
+  };
+
+  struct mathematica_mathlink_recovery
+  {
+    // This is the recovery of a link whose kernel has died (or whose link
+    // has otherwise failed). When enabled, the link is closed and opened
+    // again with its original options, and the bootstrap command (if any)
+    // is evaluated on the new kernel. If replay is set, the command that
+    // was in flight is sent once more. Only enable the replay for commands
+    // that are idempotent (such as pure evaluations).
+
+    bool          enabled   { false };
+    bool          replay    { true };
+    ::std::string bootstrap { };
+  };
+
+  enum class mathematica_mathlink_mode
+  {
+    launch,
+    connect,
+    listen
+  };
+
+  struct mathematica_mathlink_options
+  {
+    // These are the options for opening a link. The name is the kernel
+    // to launch (empty for the discovered kernel), or the port or named link
+    // to connect to or to listen on (such as 8000@localhost). The protocol is
+    // the link protocol (such as TCPIP or SharedMemory), empty for the default.
+
+    mathematica_mathlink_mode mode     { mathematica_mathlink_mode::launch };
+    ::std::string             name     { };
+    ::std::string             protocol { };
+
+    static auto str_mode(const mathematica_mathlink_mode mode) -> const char*
+    {
+      return   (mode == mathematica_mathlink_mode::connect) ? "connect"
+             : (mode == mathematica_mathlink_mode::listen)  ? "listen"
+             :                                                "launch";
+    }
+
+    static auto from_environment() -> mathematica_mathlink_options
+    {
+      const ::std::string str_mode_env { kernel_locator::str_environment("MATHEMATICA_MATHLINK_LINKMODE") };
+
+      mathematica_mathlink_options options { };
+
+      options.mode =
+          (str_mode_env == "connect") ? mathematica_mathlink_mode::connect
+        : (str_mode_env == "listen")  ? mathematica_mathlink_mode::listen
+        :                               mathematica_mathlink_mode::launch;
+
+      options.protocol = kernel_locator::str_environment("MATHEMATICA_MATHLINK_LINKPROTOCOL");
+
+      // In launch mode, the kernel is found by the kernel_locator instead.
+      if(options.mode != mathematica_mathlink_mode::launch)
+      {
+        options.name = kernel_locator::str_environment("MATHEMATICA_MATHLINK_LINKNAME");
+      }
+
+      return options;
+    }
+  };
+
   class mathematica_mathlink_base : private detail::noncopyable
   {
   public:
@@ -103,11 +372,23 @@
       return this->get_valid();
     }
 
+    auto traffic() const -> mathematica_mathlink_traffic
+    {
+      // Get the traffic counters of the link (or the sum over its links).
+      return this->get_traffic();
+    }
+
   protected:
     constexpr mathematica_mathlink_base() noexcept = default;
 
   private:
     virtual auto get_valid() const noexcept -> bool = 0;
+
+    virtual auto get_traffic() const -> mathematica_mathlink_traffic
+    {
+      // Links without any link of their own have no traffic.
+      return mathematica_mathlink_traffic { };
+    }
   };
 
   template<const char* PtrStrLocationMathLinkKernel = nullptr>
@@ -117,243 +398,1843 @@
     // This is the mathematica_mathlink class.
     // It provides access functions to WSTP.
 
-    // TBD: Make this class thread safe by using synchronization mechanisms
-    // when accessing the WSTP-objects.
-
-    mathematica_mathlink() noexcept : my_valid { open() } { }
+    // Each object of this class owns its own link to its own kernel.
+    // All of the links share one single WSTP environment.
+
+    // A link is used without any synchronization by default. Call share()
+    // (or any of the asynchronous methods) before using the link from more
+    // than one thread. From then on, every command is pushed onto a lock-free
+    // submission queue. The link I/O thread serializes the commands onto the
+    // link and fulfills their completions.
+
+    // By default, the link launches its own kernel. A link constructed with
+    // options can instead connect to a kernel that is already running and
+    // listening on a port or named link (or listen for a kernel to connect).
+    // This avoids the cold start of the kernel. The default link mode and
+    // protocol (and the link name to connect to or to listen on) can also be
+    // set in the environment variables MATHEMATICA_MATHLINK_LINKMODE,
+    // MATHEMATICA_MATHLINK_LINKPROTOCOL and MATHEMATICA_MATHLINK_LINKNAME.
+
+    // A deadline can be set for the commands of the link (see set_timeout()),
+    // or for one single command (see send_command_for()). When the deadline
+    // of a command expires, the link sends an abort message to the kernel,
+    // drains the outstanding evaluations and fails with a timeout status.
+    // A link that can not be drained is given up (see is_alive()). In addition,
+    // the evaluation can be wrapped in a kernel-side time and memory budget
+    // with TimeConstrained and MemoryConstrained (see set_kernel_budget()).
+
+    // A link can recover from the death of its kernel (see set_recovery()).
+    // It is then reopened, bootstrapped and the command in flight is replayed.
+
+    // A link can also be driven without blocking (see post_command() and
+    // poll_response()), so that one single thread can multiplex many links.
+    // See mathematica_link_reactor.h.
+
+    // The latency of each command, split into its put, wait and get phases,
+    // can be recorded into histograms (see set_latency()), optionally next to
+    // the evaluation time measured by the kernel itself. The traffic of the
+    // link (commands, bytes, packets skipped and errors) is always counted
+    // (see traffic()). The allocations of the hot paths can be counted per
+    // call site (see mathematica_mathlink_allocations.h).
+
+    // A link constructed with a trace records its session into the trace,
+    // or replays a recorded session from the trace without any kernel.
+    // See mathematica_mathlink_trace.h.
+
+    mathematica_mathlink() noexcept
+      : my_options { mathematica_mathlink_options::from_environment() },
+        my_valid   { open(my_options) } { }
+
+    explicit mathematica_mathlink(const mathematica_mathlink_options& options) noexcept
+      : my_options { options },
+        my_valid   { open(my_options) } { }
+
+    explicit mathematica_mathlink(mathematica_mathlink_trace& trace) noexcept
+      : my_trace   { &trace },
+        my_options { mathematica_mathlink_options::from_environment() },
+        my_valid   { trace.is_open() && (trace.is_replaying() || open(my_options)) } { }
 
     ~mathematica_mathlink() noexcept override
     {
+      stop_io_thread();
+
       static_cast<void>(close());
     }
 
+    using packet_type      = mathematica_mathlink_packet;
+    using packet_list_type = mathematica_mathlink_packet_list;
+
+    static constexpr auto text_packet_id   () noexcept -> int { return detail::TEXTPKT; }
+    static constexpr auto return_packet_id () noexcept -> int { return detail::RETURNPKT; }
+    static constexpr auto message_packet_id() noexcept -> int { return detail::MESSAGEPKT; }
+
     auto send_command(const ::std::string& str_cmd, ::std::string* str_rsp) const -> bool override
     {
-      const bool suppress_output { str_rsp == nullptr };
+      return run_on_link([this, &str_cmd, str_rsp]() -> bool { return do_send_command(str_cmd, str_rsp); });
+    }
 
-      const ::std::string str_cmd_local { (suppress_output ? str_cmd + ";" : str_cmd) };
+    auto is_alive() const -> bool
+    {
+      // Check that the link has not failed, for instance because its kernel died.
+      // A command that merely could not be evaluated (or whose response had an
+      // unexpected type) leaves the link alive. With recovery (see set_recovery()),
+      // a dead link is reopened on the spot.
 
-      bool
-        send_command_is_ok
-        {
-          (
-               put_function("EvaluatePacket", int { INT8_C(1) })
-            && put_function("ToExpression", int { INT8_C(1) })
-            && put_string(str_cmd_local)
-            && end_packet()
-          )
-        };
+      return (is_replaying() || run_on_link([this]() -> bool { return clear_recoverable_error(); }));
+    }
 
-      if(send_command_is_ok)
-      {
-        for(;;)
-        {
-          // NOTE: This method only works for single returned packets.
+    auto share() const -> void
+    {
+      // Start the link I/O thread, making the link safe for concurrent use.
+      ::std::call_once(my_io_once, [this]() { start_io_thread(); });
+    }
 
-          // For instance if the response from the Mathlink kernel has
-          // more than one single component, then this sequence fails.
+    auto send_command_async(const ::std::string& str_cmd, ::std::string* str_rsp) const -> ::std::future<bool>
+    {
+      // Send the command asynchronously and return immediately. The command
+      // is handled by the link I/O thread, which is started upon the first
+      // asynchronous call. From then on, the link I/O thread owns all of the
+      // WS* calls on this link. The caller must keep the response string alive
+      // until the returned future is ready.
 
-          // Maybe TODO: Extend/expand this to handle multiple returned packets.
+      const ::std::chrono::nanoseconds timeout_of_call { timeout() };
 
-          // Skip any (next)-packets before the first ReturnPacket.
-          const int next_packet_result { next_packet() };
+      // The copy of the command and the task wrapping it are allocations of the link.
+      const allocation_site site { "send_command_async" };
 
-          if(   (next_packet_result == int { INT8_C(0) })
-             || (next_packet_result == return_packet_id()))
+      return
+        post_to_io_thread
+        (
+          [this, str_cmd, str_rsp, timeout_of_call]() -> bool
           {
-            break;
-          }
+            const auto fn = [this, &str_cmd, str_rsp]() -> bool { return do_send_command(str_cmd, str_rsp); };
 
-          const int new_packet_result { new_packet() };
-
-          static_cast<void>(new_packet_result);
+            return run_call(fn, timeout_of_call);
+          }
+        );
+    }
 
-          if(error() != int { INT8_C(0) })
+    auto send_command_packets(const ::std::string& str_cmd, packet_list_type* pkt_list) const -> bool
+    {
+      // Send the command and collect all of the packets that it produces,
+      // up to and including the ReturnPacket. Text packets (such as those
+      // from Print[]) and message packets (such as warnings) are collected
+      // in the order of their arrival. The ReturnPacket is the last packet
+      // in the list.
+
+      return
+        run_on_link
+        (
+          [this, &str_cmd, pkt_list]() -> bool
           {
-            send_command_is_ok = false;
+            if(pkt_list != nullptr)
+            {
+              pkt_list->clear();
+            }
 
-            break;
+            return (put_command(str_cmd, false) && recv_packets(pkt_list, nullptr));
           }
-        }
-      }
+        );
+    }
 
-      bool recv_response_is_ok { send_command_is_ok };
+    auto send_expression(const expression& expr, ::std::string* str_rsp) const -> bool
+    {
+      // Send a structured expression. The expression is put directly on the
+      // link as EvaluatePacket[expr], without being parsed by ToExpression.
 
-      if(send_command_is_ok)
-      {
-        recv_response_is_ok = (get_string(str_rsp) && recv_response_is_ok);
-      }
+      return run_on_link([this, &expr, str_rsp]() -> bool { return (put_expression(expr, (str_rsp == nullptr)) && recv_packets(nullptr, str_rsp)); });
+    }
+
+    template<typename ValueType>
+    auto evaluate(const ::std::string& str_cmd, ValueType* p_value) const -> bool
+    {
+      // Evaluate the command and read the result directly as a typed value.
+      // The supported value types are bool (read as the symbol True or False),
+      // ::std::int64_t, double and ::std::string. No string formatting is
+      // needed on the kernel side and no parsing is needed on our side.
 
-      return (send_command_is_ok && recv_response_is_ok);
+      return run_on_link([this, &str_cmd, p_value]() -> bool { return (put_command(str_cmd, false) && recv_packets_into(nullptr, [this, p_value]() -> bool { return get_value(p_value); })); });
     }
 
-  private:
-    const bool my_valid;
+    template<typename ValueType>
+    auto evaluate(const expression& expr, ValueType* p_value) const -> bool
+    {
+      return run_on_link([this, &expr, p_value]() -> bool { return (put_expression(expr, false) && recv_packets_into(nullptr, [this, p_value]() -> bool { return get_value(p_value); })); });
+    }
 
-    static WSENV  env_ptr;
-    static WSLINK lnk_ptr;
+    template<typename LimbIterator>
+    auto evaluate_limbs(const expression& expr, LimbIterator first, LimbIterator last) const -> bool
+    {
+      // Evaluate an expression having a non-negative integer result and
+      // read the result in binary form directly into the limbs [first, last),
+      // least significant limb first. The kernel sends the integer as
+      // IntegerDigits[expr, 2^32]. The limbs that are not needed are zeroed.
+      // The evaluation fails if the result does not fit into the limbs.
+
+      const expression
+        expr_digits
+        {
+          head("IntegerDigits").arg(expr).arg(expression::limbs_radix())
+        };
 
-    constexpr auto get_valid() const noexcept -> bool override
+      return run_on_link([this, &expr_digits, first, last]() -> bool { return (put_expression(expr_digits, false) && recv_packets_into(nullptr, [this, first, last]() -> bool { return get_limbs(first, last); })); });
+    }
+
+    template<typename LimbIterator>
+    auto evaluate_limbs(const ::std::string& str_cmd, LimbIterator first, LimbIterator last) const -> bool
     {
-      return my_valid;
+      return evaluate_limbs(head("ToExpression").arg(str_cmd), first, last);
+    }
+
+    #if defined(MATHEMATICA_MATHLINK_HAS_STRING_VIEW)
+    template<typename VisitorType>
+    auto send_command_view(const ::std::string& str_cmd, VisitorType visitor) const -> bool
+    {
+      // Send the command and hand the response to the visitor as a string_view
+      // directly over the buffer owned by WSTP. The response is not copied.
+      // The string_view is valid only until the visitor returns.
+
+      return
+        run_on_link
+        (
+          [this, &str_cmd, &visitor]() -> bool
+          {
+            return
+            (
+                 put_command(str_cmd, false)
+              && recv_packets_into(nullptr, [this, &visitor]() -> bool { return get_string_view(visitor); })
+            );
+          }
+        );
     }
+    #endif
 
-    static constexpr auto return_packet_id() noexcept -> int
+    auto send_batch(const ::std::vector<::std::string>& str_cmds, ::std::vector<::std::string>* str_rsps) const -> bool
     {
-      return detail::RETURNPKT;
+      // Send a batch of commands in pipelined fashion. All of the EvaluatePackets
+      // are written back to back, so that the kernel can start on the next command
+      // while we are still reading. Then the ReturnPackets are read in the order
+      // of the commands. The responses are sized to the batch even when
+      // the link is not valid, so that they can always be indexed.
+
+      resize_responses(str_cmds.size(), str_rsps);
+
+      return run_on_link([this, &str_cmds, str_rsps]() -> bool { return do_send_batch(str_cmds, str_rsps); });
     }
 
-    static WSENV&  global_env_ptr() noexcept { return env_ptr; }
-    static WSLINK& global_lnk_ptr() noexcept { return lnk_ptr; }
+    auto send_expression_batch(const ::std::vector<expression>& exprs, ::std::vector<::std::string>* str_rsps) const -> bool
+    {
+      // Send a batch of structured expressions in pipelined fashion.
+
+      resize_responses(exprs.size(), str_rsps);
 
-    static auto next_packet ()                                   noexcept -> int  { return  ::WSNextPacket (global_lnk_ptr()); }
-    static auto new_packet  ()                                   noexcept -> int  { return  ::WSNewPacket  (global_lnk_ptr()); }
-    static auto put_function(const ::std::string& str, int argc) noexcept -> bool { return (::WSPutFunction(global_lnk_ptr(), str.c_str(), argc) != 0); }
-    static auto put_string  (const ::std::string& str)           noexcept -> bool { return (::WSPutString  (global_lnk_ptr(), str.c_str()) != 0); }
-    static auto end_packet  ()                                   noexcept -> bool { return (::WSEndPacket  (global_lnk_ptr()) != 0); }
-    static auto error       ()                                   noexcept -> int  { return  ::WSError      (global_lnk_ptr()); }
+      return run_on_link([this, &exprs, str_rsps]() -> bool { return do_send_batch(exprs, str_rsps); });
+    }
 
-    static auto get_string(::std::string* str_rsp) -> bool
+    auto send_command_for(const ::std::string& str_cmd, ::std::string* str_rsp, const ::std::chrono::nanoseconds timeout_of_call) const -> mathematica_mathlink_status
     {
-      const char* p_str_rsp_ws_get { nullptr };
+      // Send the command with a deadline of its own, in place of the timeout of the link.
+
+      bool call_timed_out { false };
 
       const bool
-        result_get_string_is_ok
+        result_send_is_ok
         {
-          (::WSGetString(global_lnk_ptr(), &p_str_rsp_ws_get) != static_cast<int>(INT8_C(0)))
+          run_on_link
+          (
+            [this, &str_cmd, str_rsp, &call_timed_out]() -> bool
+            {
+              const bool result_do_send_is_ok { do_send_command(str_cmd, str_rsp) };
+
+              call_timed_out = my_call_timed_out;
+
+              return result_do_send_is_ok;
+            },
+            timeout_of_call
+          )
         };
 
-      if((str_rsp != nullptr) && result_get_string_is_ok)
-      {
-        const ::std::size_t rsp_len_ws_get { detail::strlen_unsafe(p_str_rsp_ws_get) };
+      return   result_send_is_ok ? mathematica_mathlink_status::ok
+             : call_timed_out    ? mathematica_mathlink_status::timeout
+             :                     mathematica_mathlink_status::failed;
+    }
 
-        str_rsp->resize(rsp_len_ws_get);
+    auto set_timeout(const ::std::chrono::nanoseconds timeout_of_link) noexcept -> void
+    {
+      // Set the deadline for each command (or batch) of the link, zero for none.
+      my_timeout_ns.store(static_cast<::std::int64_t>(timeout_of_link.count()));
+    }
 
-        static_cast<void>(::std::copy(p_str_rsp_ws_get, p_str_rsp_ws_get + rsp_len_ws_get, str_rsp->begin()));
-      }
+    auto timeout () const noexcept -> ::std::chrono::nanoseconds { return ::std::chrono::nanoseconds { my_timeout_ns.load() }; }
+    auto timeouts() const noexcept -> ::std::uint64_t            { return my_timeouts.load(); }
 
-      ::WSReleaseString(global_lnk_ptr(), p_str_rsp_ws_get);
+    auto set_kernel_budget(const ::std::chrono::milliseconds time_budget, const ::std::uint64_t memory_budget_bytes) noexcept -> void
+    {
+      // Wrap each evaluation in TimeConstrained and MemoryConstrained, zero for none.
+      // An evaluation that exceeds its budget returns $Aborted.
+      my_time_budget_ms.store(static_cast<::std::int64_t>(time_budget.count()));
+      my_memory_budget .store(static_cast<::std::int64_t>(memory_budget_bytes));
+    }
 
-      return result_get_string_is_ok;
+    auto set_recovery(const mathematica_mathlink_recovery& recovery) -> void
+    {
+      // Set the recovery of the link. Call this before sending any commands.
+      my_recovery = recovery;
     }
 
-    static auto is_open() noexcept -> bool
+    auto recoveries() const noexcept -> ::std::uint64_t { return my_recoveries.load(); }
+
+    auto set_latency(mathematica_mathlink_latency* p_latency, const bool kernel_timing = false) -> void
     {
-      return ((global_env_ptr() != nullptr) && (global_lnk_ptr() != nullptr));
+      // Record the latency of each command into the histograms, null for none.
+      // Call this before sending any commands. The histograms must outlive the link.
+
+      // With kernel timing, each evaluation is wrapped in AbsoluteTiming, and the
+      // time measured by the kernel is stripped from the result and recorded next
+      // to the round trip. String commands are sent as ToExpression[str, InputForm,
+      // AbsoluteTiming], so that the parsing is not part of the kernel time.
+      // An evaluation aborted by its kernel budget then fails, since its result
+      // is no longer a timing.
+
+      my_latency               = p_latency;
+      my_latency_kernel_timing = ((p_latency != nullptr) && kernel_timing);
     }
 
-    static auto do_open(const ::std::string& str_location_math_kernel_user) noexcept -> bool
+    // The following methods drive the link without ever blocking on it.
+    // They are meant for one single owner that multiplexes many links,
+    // such as mathematica_link_reactor (see mathematica_link_reactor.h),
+    // and they must not be mixed with share() or the asynchronous methods.
+
+    auto post_command(const ::std::string& str_cmd, const bool suppress_output) const -> bool
     {
-      // Create a list of constant arguments for opening the mathlink kernel.
-      using const_args_string_array_type = ::std::array<::std::string, ::std::size_t { UINT8_C(5) }>;
+      // Put the command on the link and return without waiting for its response.
+      // The responses of posted commands arrive in the order of posting.
 
-      const const_args_string_array_type
-        const_args_strings
-        {
-          ::std::string("-linkname"),
-          str_location_math_kernel_user,
-          ::std::string("-linkmode"),
-          ::std::string("launch"),
-          ::std::string()
-        };
+      mathematica_mathlink_timeline::instance().instant("submit", "link");
 
-      ::std::vector<char> c0(::std::size_t { UINT8_C(1024) }, '\0'); detail::strcpy_unsafe(c0.data(), const_args_strings[static_cast<std::size_t>(UINT8_C(0))].c_str());
-      ::std::vector<char> c1(::std::size_t { UINT8_C(4096) }, '\0'); detail::strcpy_unsafe(c1.data(), const_args_strings[static_cast<std::size_t>(UINT8_C(1))].c_str());
-      ::std::vector<char> c2(::std::size_t { UINT8_C(1024) }, '\0'); detail::strcpy_unsafe(c2.data(), const_args_strings[static_cast<std::size_t>(UINT8_C(2))].c_str());
-      ::std::vector<char> c3(::std::size_t { UINT8_C(1024) }, '\0'); detail::strcpy_unsafe(c3.data(), const_args_strings[static_cast<std::size_t>(UINT8_C(3))].c_str());
+      const bool result_put_is_ok { my_valid && (!my_broken.load()) && put_command(str_cmd, suppress_output) };
 
-      // Create a list of non-constant character pointers for opening the mathlink kernel.
-      using nonconst_args_ptrs_array_type = ::std::array<char*, ::std::tuple_size<const_args_string_array_type>::value>;
+      if(result_put_is_ok && (!is_replaying()))
+      {
+        static_cast<void>(::WSFlush(my_lnk_ptr));
+      }
+      else if(my_valid && (!my_broken.load()))
+      {
+        static_cast<void>(clear_recoverable_error());
+      }
 
-      auto nonconst_args_pointers =
-        nonconst_args_ptrs_array_type
-        {
-          c0.data(),
-          c1.data(),
-          c2.data(),
-          c3.data(),
-          nullptr
-        };
+      return result_put_is_ok;
+    }
+
+    auto is_ready() const -> bool
+    {
+      // Check whether a packet can be read without blocking.
+      return (is_replaying() || (::WSReady(my_lnk_ptr) != int { INT8_C(0) }));
+    }
 
-      // Open the mathlink kernel.
-      global_lnk_ptr() = ::WSOpen(static_cast<int>(const_args_strings.size()), nonconst_args_pointers.data());
+    auto poll_response(::std::string* str_rsp, bool* p_done) const -> bool
+    {
+      // Receive those packets of the oldest posted command that are ready,
+      // without blocking. The response is complete (and p_done is set)
+      // once its ReturnPacket has been read. This is the same packet step
+      // as the one used by the blocking receive of send_command().
 
-      if(global_lnk_ptr() == nullptr)
-      {
-        ::WSDeinitialize(global_env_ptr());
+      const auto get_return = [this, str_rsp]() -> bool { return get_string(str_rsp); };
 
-        global_env_ptr() = nullptr;
+      bool result_recv_is_ok { true };
+
+      *p_done = false;
+
+      while(result_recv_is_ok && (!(*p_done)) && is_ready())
+      {
+        result_recv_is_ok = recv_packet(nullptr, get_return, p_done);
       }
 
-      return is_open();
+      return result_recv_is_ok;
     }
 
-    static auto str_location_mathlink_kernel_default() -> ::std::string
+  private:
+    struct io_request_type
     {
-      // TBD: Is it possible (or sensible) to query the Win* registry
-      // in order to find the default location of the mathlink kernel?
+      ::std::function<bool()> task   { };
+      ::std::promise<bool>    result { };
+    };
 
-      // TBD: What about supporting non-Win* platforms like *nix?
+    using latency_time_point = ::std::chrono::steady_clock::time_point;
 
-      constexpr char
-        str_location_math_kernel_default[]
-        {
-          "\"C:\\Program Files\\Wolfram Research\\Mathematica\\14.0\\MathKernel.exe\""
-        };
+    struct latency_sample_type
+    {
+      latency_phases*    p_phases         { nullptr };
+      latency_time_point put_start        { };
+      latency_time_point put_end          { };
+      latency_time_point first_packet     { };
+      bool               has_first_packet { false };
+      ::std::uint64_t    kernel_ns        { };
+    };
+
+    mutable WSENV                      my_env_ptr { nullptr };
+    mutable WSLINK                     my_lnk_ptr { nullptr };
+    mathematica_mathlink_trace* const  my_trace   { nullptr };
+    const mathematica_mathlink_options my_options;
+    const bool                         my_valid;
+
+    mutable detail::mpsc_queue<io_request_type> my_io_queue    { };
+    mutable ::std::mutex                        my_io_mutex    { };
+    mutable ::std::condition_variable           my_io_cond     { };
+    mutable ::std::thread                       my_io_thread   { };
+    mutable ::std::once_flag                    my_io_once     { };
+    mutable ::std::atomic<bool>                 my_io_running  { false };
+    mutable ::std::atomic<bool>                 my_io_sleeping { false };
+    mutable bool                                my_io_stop     { false };
+
+    ::std::atomic<::std::int64_t>               my_timeout_ns     { };
+    ::std::atomic<::std::int64_t>               my_time_budget_ms { };
+    ::std::atomic<::std::int64_t>               my_memory_budget  { };
+    mutable ::std::atomic<::std::uint64_t>      my_timeouts       { };
+    mutable ::std::atomic<bool>                 my_broken         { false };
+
+    mathematica_mathlink_recovery               my_recovery       { };
+    mutable ::std::atomic<::std::uint64_t>      my_recoveries     { };
+
+    mutable traffic_counters                    my_traffic        { };
+
+    // The latency samples of the commands in flight, owned by the thread making the WS* calls.
+    mathematica_mathlink_latency*                               my_latency             { nullptr };
+    bool                                                        my_latency_kernel_timing { false };
+    mutable ::std::deque<latency_sample_type>                   my_latency_samples     { };
+    mutable ::std::string                                       my_latency_last_head   { };
+    mutable latency_phases*                                     my_latency_last_phases { nullptr };
+    mutable latency_time_point                                  my_latency_recv_start  { };
+
+    // The state of the call in progress, owned by the thread making the WS* calls.
+    mutable ::std::chrono::steady_clock::time_point my_call_deadline     { };
+    mutable bool                                    my_call_has_deadline { false };
+    mutable bool                                    my_call_timed_out    { false };
+    mutable ::std::size_t                           my_pending           { };
 
-      return ::std::string { str_location_math_kernel_default };
+    constexpr auto get_valid() const noexcept -> bool override
+    {
+      return my_valid;
     }
 
-    static auto open(const char* pstr_location_math_kernel_user = nullptr) noexcept -> bool
+    auto get_traffic() const -> mathematica_mathlink_traffic override
     {
-      bool result_do_open_is_ok { };
+      return my_traffic.snapshot();
+    }
 
-      if(is_open())
+    template<typename FunctionType>
+    auto run_on_link(FunctionType fn) const -> bool
+    {
+      return run_on_link(fn, timeout());
+    }
+
+    template<typename FunctionType>
+    auto run_on_link(FunctionType fn, const ::std::chrono::nanoseconds timeout_of_call) const -> bool
+    {
+      // Once the link I/O thread is running, it owns all of the WS* calls.
+      // Synchronous calls are then handed over to it and waited for.
+      // Nothing is sent on a link that failed to open.
+
+      const auto call = [this, &fn, timeout_of_call]() -> bool { return run_call(fn, timeout_of_call); };
+
+      return (my_valid && (my_io_running.load() ? post_to_io_thread(call).get() : call()));
+    }
+
+    template<typename FunctionType>
+    auto run_call(FunctionType& fn, const ::std::chrono::nanoseconds timeout_of_call) const -> bool
+    {
+      // Make one call on the link, on the thread that owns the WS* calls.
+      // Nothing is sent on a link that has been given up, unless it can be
+      // recovered. With recovery, the call during which the link died is
+      // replayed once on the reopened link (but not a call that timed out).
+
+      const timeline_scope scope_command { "command", "link" };
+
+      if(my_broken.load() && (!recover()))
       {
-        result_do_open_is_ok = true;
+        return false;
       }
-      else
+
+      begin_call(timeout_of_call);
+
+      bool result_call_is_ok { fn() };
+
+      if((!result_call_is_ok) && has_died())
       {
-        global_env_ptr() = ::WSInitialize(nullptr);
+        const bool replay_is_allowed { my_recovery.replay && (!my_call_timed_out) };
 
-        if(global_env_ptr() != nullptr)
+        if(recover() && replay_is_allowed)
         {
-          result_do_open_is_ok =
-            do_open
-            (
-              (pstr_location_math_kernel_user == nullptr) ? str_location_mathlink_kernel_default()
-                                                          : ::std::string(pstr_location_math_kernel_user)
-            );
+          begin_call(timeout_of_call);
+
+          result_call_is_ok = fn();
         }
       }
+      else if(!result_call_is_ok)
+      {
+        // A failed put or get leaves its error pending. Clear it for the next call.
+        static_cast<void>(clear_recoverable_error());
+      }
 
-      return result_do_open_is_ok;
+      return result_call_is_ok;
     }
 
-    static auto close() noexcept -> bool
+    auto recovery_is_enabled() const noexcept -> bool
     {
-      const bool result_close_is_ok { is_open() };
+      // A traced session can not be recovered, since its replay would differ.
+      return (my_recovery.enabled && (my_trace == nullptr));
+    }
 
-      if(global_lnk_ptr() != nullptr)
-      {
-        static_cast<void>(::WSClose(global_lnk_ptr()));
+    auto has_died() const -> bool
+    {
+      return (recovery_is_enabled() && (my_broken.load() || (!is_open()) || error_is_fatal(error())));
+    }
 
-        global_lnk_ptr() = nullptr;
-      }
+    static constexpr auto error_is_fatal(const int error_code) noexcept -> bool
+    {
+      // Only these errors mean that the link itself has failed, such as by
+      // the death of its kernel. Any other error (such as a get of the wrong
+      // type) concerns one single call, and it can be cleared.
 
-      if(global_env_ptr() != nullptr)
-      {
-        ::WSDeinitialize(global_env_ptr());
+      return (   (error_code == detail::WSEDEAD)
+              || (error_code == detail::WSECLOSED)
+              || (error_code == detail::WSEABORT));
+    }
 
-        global_env_ptr() = nullptr;
-      }
+    auto clear_recoverable_error() const -> bool
+    {
+      // As in WSTP, an error is sticky, and the calls on the link fail until
+      // it is cleared. Clear a recoverable error and skip the rest of the
+      // current packet. A link whose error can not be cleared is given up.
+      // The result tells whether the link is usable.
 
-      return result_close_is_ok;
+      const int error_code { error() };
+
+      if(error_code == detail::WSEOK)
+      {
+        return true;
+      }
+
+      const bool result_clear_is_ok { (!error_is_fatal(error_code)) && (clear_error() != int { INT8_C(0) }) };
+
+      if(result_clear_is_ok)
+      {
+        static_cast<void>(new_packet());
+      }
+      else
+      {
+        my_broken.store(true);
+      }
+
+      return result_clear_is_ok;
+    }
+
+    auto recover() const -> bool
+    {
+      // Close the dead link and open it again with the very same options,
+      // then evaluate the bootstrap command (if any) on the new kernel.
+
+      if(!recovery_is_enabled())
+      {
+        return false;
+      }
+
+      static_cast<void>(close());
+
+      my_pending = ::std::size_t { UINT8_C(0) };
+
+      my_latency_samples.clear();
+
+      begin_call(timeout());
+
+      const bool
+        result_recover_is_ok
+        {
+             open(my_options)
+          && (my_recovery.bootstrap.empty() || do_send_command(my_recovery.bootstrap, nullptr))
+        };
+
+      my_broken.store(!result_recover_is_ok);
+
+      if(result_recover_is_ok)
+      {
+        ++my_recoveries;
+      }
+
+      return result_recover_is_ok;
+    }
+
+    auto begin_call(const ::std::chrono::nanoseconds timeout_of_call) const -> void
+    {
+      my_call_timed_out    = false;
+      my_call_has_deadline = (timeout_of_call.count() > 0);
+
+      if(my_call_has_deadline)
+      {
+        my_call_deadline = ::std::chrono::steady_clock::now() + timeout_of_call;
+      }
+    }
+
+    static constexpr auto abort_grace() noexcept -> ::std::chrono::seconds { return ::std::chrono::seconds { 5 }; }
+
+    static constexpr auto ready_yield_rounds() noexcept -> unsigned { return unsigned { UINT8_C(64) }; }
+
+    static constexpr auto ready_backoff_min() noexcept -> ::std::chrono::microseconds { return ::std::chrono::microseconds { 5 }; }
+    static constexpr auto ready_backoff_max() noexcept -> ::std::chrono::microseconds { return ::std::chrono::microseconds { 40 }; }
+
+    auto wait_ready_until(const ::std::chrono::steady_clock::time_point deadline) const -> bool
+    {
+      // Poll the link until data is ready to be read, or until the deadline
+      // expires. As in the reactor, the link yields first, and then backs off
+      // for a few tens of microseconds at most, since the backoff adds directly
+      // to the latency of a response that has already arrived.
+
+      static_cast<void>(::WSFlush(my_lnk_ptr));
+
+      unsigned                    idle_rounds { };
+      ::std::chrono::microseconds backoff     { ready_backoff_min() };
+
+      while(::WSReady(my_lnk_ptr) == int { INT8_C(0) })
+      {
+        const ::std::chrono::steady_clock::time_point now { ::std::chrono::steady_clock::now() };
+
+        if(now >= deadline)
+        {
+          return false;
+        }
+
+        if(idle_rounds < ready_yield_rounds())
+        {
+          ++idle_rounds;
+
+          ::std::this_thread::yield();
+        }
+        else
+        {
+          ::std::this_thread::sleep_for((::std::min)(::std::chrono::duration_cast<::std::chrono::nanoseconds>(backoff), ::std::chrono::duration_cast<::std::chrono::nanoseconds>(deadline - now)));
+
+          backoff = (::std::min)(backoff * 2, ready_backoff_max());
+        }
+      }
+
+      return true;
+    }
+
+    auto wait_ready() const -> bool
+    {
+      // Without a deadline (and during replay), next_packet() simply blocks.
+
+      if((!my_call_has_deadline) || is_replaying())
+      {
+        return true;
+      }
+
+      const timeline_scope scope_wait { "wait", "link" };
+
+      return wait_ready_until(my_call_deadline);
+    }
+
+    auto abort_and_drain() const -> void
+    {
+      // Abort the evaluation in progress, and drain each outstanding evaluation
+      // of the call, so that the link is left in a known state. Evaluations queued
+      // behind the aborted one are aborted in turn. A link that can not be drained
+      // within the grace period is given up. The abort message is not traced.
+
+      my_call_timed_out = true;
+
+      ++my_timeouts;
+
+      const ::std::chrono::steady_clock::time_point deadline { ::std::chrono::steady_clock::now() + abort_grace() };
+
+      while(my_pending != ::std::size_t { UINT8_C(0) })
+      {
+        static_cast<void>(::WSPutMessage(my_lnk_ptr, detail::WSAbortMessage));
+
+        for(bool is_return_packet { false }; !is_return_packet; )
+        {
+          const int next_packet_result { wait_ready_until(deadline) ? next_packet() : int { INT8_C(0) } };
+
+          if(next_packet_result == int { INT8_C(0) })
+          {
+            my_broken.store(true);
+
+            return;
+          }
+
+          static_cast<void>(new_packet());
+
+          is_return_packet = (next_packet_result == return_packet_id());
+
+          count_packet(next_packet_result, true);
+        }
+
+        --my_pending;
+      }
+
+      my_latency_samples.clear();
+    }
+
+    auto post_to_io_thread(::std::function<bool()> task) const -> ::std::future<bool>
+    {
+      if(!my_valid)
+      {
+        ::std::promise<bool> result_invalid { };
+
+        result_invalid.set_value(false);
+
+        return result_invalid.get_future();
+      }
+
+      share();
+
+      mathematica_mathlink_timeline::instance().instant("submit", "link");
+
+      const allocation_site site { "post_to_io_thread" };
+
+      io_request_type req { ::std::move(task), ::std::promise<bool> { } };
+
+      ::std::future<bool> ftr { req.result.get_future() };
+
+      my_io_queue.push(::std::move(req));
+
+      // The mutex is only needed when the link I/O thread is going to sleep.
+      // The fences on both sides ensure that either the producer sees the
+      // sleeping flag or the link I/O thread sees the new request.
+      ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+
+      if(my_io_sleeping.load(::std::memory_order_relaxed))
+      {
+        {
+          const ::std::lock_guard<::std::mutex> lock { my_io_mutex };
+        }
+
+        my_io_cond.notify_one();
+      }
+
+      return ftr;
+    }
+
+    auto start_io_thread() const -> void
+    {
+      my_io_thread = ::std::thread { [this]() { io_thread_loop(); } };
+
+      my_io_running.store(true);
+    }
+
+    auto stop_io_thread() noexcept -> void
+    {
+      if(my_io_running.load())
+      {
+        {
+          const ::std::lock_guard<::std::mutex> lock { my_io_mutex };
+
+          my_io_stop = true;
+        }
+
+        my_io_cond.notify_one();
+
+        my_io_thread.join();
+
+        my_io_running.store(false);
+      }
+    }
+
+    auto io_thread_loop() const -> void
+    {
+      // Serve the requests in the order of their arrival. Any requests
+      // that are still queued when stopping are finished before leaving.
+      // The request is reused, since a default promise allocates its state.
+
+      const allocation_site site { "io_thread_loop" };
+
+      io_request_type req { };
+
+      for(;;)
+      {
+        if(my_io_queue.try_pop(&req))
+        {
+          req.result.set_value(req.task());
+
+          continue;
+        }
+
+        ::std::unique_lock<::std::mutex> lock { my_io_mutex };
+
+        my_io_sleeping.store(true, ::std::memory_order_relaxed);
+
+        ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+
+        my_io_cond.wait(lock, [this]() { return (my_io_stop || (!my_io_queue.empty())); });
+
+        my_io_sleeping.store(false, ::std::memory_order_relaxed);
+
+        if(my_io_stop && my_io_queue.empty())
+        {
+          break;
+        }
+      }
+    }
+
+    auto do_send_command(const ::std::string& str_cmd, ::std::string* str_rsp) const -> bool
+    {
+      const bool suppress_output { str_rsp == nullptr };
+
+      return (put_command(str_cmd, suppress_output) && recv_packets(nullptr, str_rsp));
+    }
+
+    static auto resize_responses(const ::std::size_t count, ::std::vector<::std::string>* str_rsps) -> void
+    {
+      if(str_rsps != nullptr)
+      {
+        str_rsps->resize(count);
+      }
+    }
+
+    template<typename CommandType>
+    auto do_send_batch(const ::std::vector<CommandType>& str_cmds, ::std::vector<::std::string>* str_rsps) const -> bool
+    {
+      const bool suppress_output { str_rsps == nullptr };
+
+      ::std::size_t count_put { ::std::size_t { UINT8_C(0) } };
+
+      for(const CommandType& str_cmd : str_cmds)
+      {
+        if(!put_command(str_cmd, suppress_output))
+        {
+          break;
+        }
+
+        ++count_put;
+      }
+
+      bool recv_response_is_ok { (count_put == str_cmds.size()) };
+
+      // Drain every command that has actually been put on the link,
+      // even if an error has occurred along the way.
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < count_put; ++index)
+      {
+        ::std::string* p_str_rsp { suppress_output ? nullptr : &(*str_rsps)[index] };
+
+        recv_response_is_ok = (recv_packets(nullptr, p_str_rsp) && recv_response_is_ok);
+      }
+
+      return recv_response_is_ok;
+    }
+
+    auto is_replaying() const noexcept -> bool { return ((my_trace != nullptr) && my_trace->is_replaying()); }
+
+    template<typename CallType>
+    auto traced_call(const trace_op op,
+                     CallType call,
+                     const char* p_bytes = nullptr,
+                     const ::std::size_t byte_count = ::std::size_t { UINT8_C(0) },
+                     const ::std::int64_t* p_list = nullptr,
+                     const ::std::size_t list_count = ::std::size_t { UINT8_C(0) }) const -> int
+    {
+      // Make a WS* call having no output other than its result. With a trace,
+      // the call is either recorded or replayed (without being made at all).
+
+      if(my_trace == nullptr)
+      {
+        return call();
+      }
+
+      if(my_trace->is_replaying())
+      {
+        return my_trace->replay_put(op, p_bytes, byte_count, p_list, list_count);
+      }
+
+      const int result { call() };
+
+      my_trace->record(op, result, p_bytes, byte_count, p_list, list_count);
+
+      return result;
+    }
+
+    auto next_packet() const -> int { return traced_call(trace_op::next_packet, [this]() { return ::WSNextPacket(my_lnk_ptr); }); }
+    auto new_packet () const -> int { return traced_call(trace_op::new_packet,  [this]() { return ::WSNewPacket (my_lnk_ptr); }); }
+    auto error      () const -> int { return traced_call(trace_op::error,       [this]() { return ::WSError     (my_lnk_ptr); }); }
+    auto clear_error() const -> int { return traced_call(trace_op::clear_error, [this]() { return ::WSClearError(my_lnk_ptr); }); }
+
+    auto end_packet() const -> bool { return (traced_call(trace_op::end_packet, [this]() { return ::WSEndPacket(my_lnk_ptr); }) != 0); }
+
+    auto put_function(const char* p_str, int argc) const -> bool
+    {
+      // As for put_symbol(), the head is taken as is (rather than as a string),
+      // so that putting a literal head never allocates.
+
+      const ::std::size_t  len    { ::std::strlen(p_str) };
+      const ::std::int64_t argc64 { argc };
+
+      return count_put((traced_call(trace_op::put_function, [this, p_str, argc]() { return ::WSPutFunction(my_lnk_ptr, p_str, argc); }, p_str, len, &argc64, ::std::size_t { UINT8_C(1) }) != 0), len);
+    }
+
+    auto put_string(const ::std::string& str) const -> bool
+    {
+      return count_put((traced_call(trace_op::put_string, [this, &str]() { return ::WSPutString(my_lnk_ptr, str.c_str()); }, str.data(), str.size()) != 0), str.size());
+    }
+
+    auto put_symbol(const char* p_str) const -> bool
+    {
+      const ::std::size_t len { ::std::strlen(p_str) };
+
+      return count_put((traced_call(trace_op::put_symbol, [this, p_str]() { return ::WSPutSymbol(my_lnk_ptr, p_str); }, p_str, len) != 0), len);
+    }
+
+    auto put_integer64(const ::std::int64_t n) const -> bool
+    {
+      return count_put((traced_call(trace_op::put_integer64, [this, n]() { return ::WSPutInteger64(my_lnk_ptr, n); }, nullptr, ::std::size_t { UINT8_C(0) }, &n, ::std::size_t { UINT8_C(1) }) != 0), sizeof(::std::int64_t));
+    }
+
+    auto put_integer64_list(const ::std::vector<::std::int64_t>& list) const -> bool
+    {
+      return count_put((traced_call(trace_op::put_integer64_list, [this, &list]() { return ::WSPutInteger64List(my_lnk_ptr, list.data(), static_cast<int>(list.size())); }, nullptr, ::std::size_t { UINT8_C(0) }, list.data(), list.size()) != 0), list.size() * sizeof(::std::int64_t));
+    }
+
+    auto put_integer_digits(const ::std::string& str_digits) const -> bool
+    {
+      // Put an integer of arbitrary size as a token of type integer
+      // with the given decimal digits.
+
+      const ::std::int64_t type64 { detail::WSTKINT };
+      const ::std::int64_t size64 { static_cast<::std::int64_t>(str_digits.size()) };
+
+      return
+      (
+           (traced_call(trace_op::put_next, [this]() { return ::WSPutNext(my_lnk_ptr, detail::WSTKINT); }, nullptr, ::std::size_t { UINT8_C(0) }, &type64, ::std::size_t { UINT8_C(1) }) != 0)
+        && (traced_call(trace_op::put_size, [this, &str_digits]() { return ::WSPutSize(my_lnk_ptr, static_cast<int>(str_digits.size())); }, nullptr, ::std::size_t { UINT8_C(0) }, &size64, ::std::size_t { UINT8_C(1) }) != 0)
+        && count_put((traced_call(trace_op::put_data, [this, &str_digits]() { return ::WSPutData(my_lnk_ptr, str_digits.c_str(), static_cast<int>(str_digits.size())); }, str_digits.data(), str_digits.size()) != 0), str_digits.size())
+      );
+    }
+
+    auto count_put(const bool put_is_ok, const ::std::size_t byte_count) const noexcept -> bool
+    {
+      // Only the traffic of a live link is counted (not that of a replay).
+
+      if(put_is_ok && (!is_replaying()))
+      {
+        my_traffic.add_put(byte_count);
+      }
+
+      return put_is_ok;
+    }
+
+    auto get_symbol(const char** pp_str) const -> bool
+    {
+      if(is_replaying())
+      {
+        const trace_record* p_rec { my_trace->replay(trace_op::get_symbol) };
+
+        *pp_str = ((p_rec != nullptr) ? p_rec->bytes.c_str() : nullptr);
+
+        return ((p_rec != nullptr) && (p_rec->result != ::std::int64_t { INT8_C(0) }));
+      }
+
+      const int result { ::WSGetSymbol(my_lnk_ptr, pp_str) };
+
+      if(result != 0) { my_traffic.add_received(::std::strlen(*pp_str)); }
+
+      if(my_trace != nullptr)
+      {
+        my_trace->record(trace_op::get_symbol, result, *pp_str, ((result != 0) ? ::std::strlen(*pp_str) : ::std::size_t { UINT8_C(0) }));
+      }
+
+      return (result != 0);
+    }
+
+    auto test_head(const char* p_str_head, int* p_argc) const -> bool
+    {
+      if(is_replaying())
+      {
+        const trace_record* p_rec { my_trace->replay(trace_op::test_head) };
+
+        const bool result_test_is_ok { (p_rec != nullptr) && (p_rec->result != ::std::int64_t { INT8_C(0) }) && (p_rec->bytes == p_str_head) && (p_rec->list.size() == ::std::size_t { UINT8_C(1) }) };
+
+        if(result_test_is_ok) { *p_argc = static_cast<int>(p_rec->list.front()); }
+
+        return result_test_is_ok;
+      }
+
+      const int result { ::WSTestHead(my_lnk_ptr, p_str_head, p_argc) };
+
+      if(my_trace != nullptr)
+      {
+        const ::std::int64_t argc64 { *p_argc };
+
+        my_trace->record(trace_op::test_head, result, p_str_head, ::std::strlen(p_str_head), &argc64, ((result != 0) ? ::std::size_t { UINT8_C(1) } : ::std::size_t { UINT8_C(0) }));
+      }
+
+      return (result != 0);
+    }
+
+    auto release_symbol(const char* p_str) const -> void
+    {
+      if(!is_replaying())
+      {
+        ::WSReleaseSymbol(my_lnk_ptr, p_str);
+      }
+    }
+
+    auto get_integer64(::std::int64_t* p_value) const -> bool
+    {
+      if(is_replaying())
+      {
+        const trace_record* p_rec { my_trace->replay(trace_op::get_integer64) };
+
+        const bool result_get_is_ok { (p_rec != nullptr) && (p_rec->result != ::std::int64_t { INT8_C(0) }) && (p_rec->list.size() == ::std::size_t { UINT8_C(1) }) };
+
+        if(result_get_is_ok) { *p_value = p_rec->list.front(); }
+
+        return result_get_is_ok;
+      }
+
+      const int result { ::WSGetInteger64(my_lnk_ptr, p_value) };
+
+      if(result != 0) { my_traffic.add_received(sizeof(::std::int64_t)); }
+
+      if(my_trace != nullptr)
+      {
+        my_trace->record(trace_op::get_integer64, result, nullptr, ::std::size_t { UINT8_C(0) }, p_value, ((result != 0) ? ::std::size_t { UINT8_C(1) } : ::std::size_t { UINT8_C(0) }));
+      }
+
+      return (result != 0);
+    }
+
+    auto get_real64(double* p_value) const -> bool
+    {
+      // The real value is traced bit for bit.
+      static_assert(sizeof(double) == sizeof(::std::int64_t), "Error: The tracing of double assumes a 64-bit double");
+
+      ::std::int64_t bits { };
+
+      if(is_replaying())
+      {
+        const trace_record* p_rec { my_trace->replay(trace_op::get_real64) };
+
+        const bool result_get_is_ok { (p_rec != nullptr) && (p_rec->result != ::std::int64_t { INT8_C(0) }) && (p_rec->list.size() == ::std::size_t { UINT8_C(1) }) };
+
+        if(result_get_is_ok) { bits = p_rec->list.front(); ::std::memcpy(p_value, &bits, sizeof(double)); }
+
+        return result_get_is_ok;
+      }
+
+      const int result { ::WSGetReal64(my_lnk_ptr, p_value) };
+
+      if(result != 0) { my_traffic.add_received(sizeof(double)); }
+
+      if(my_trace != nullptr)
+      {
+        ::std::memcpy(&bits, p_value, sizeof(double));
+
+        my_trace->record(trace_op::get_real64, result, nullptr, ::std::size_t { UINT8_C(0) }, &bits, ((result != 0) ? ::std::size_t { UINT8_C(1) } : ::std::size_t { UINT8_C(0) }));
+      }
+
+      return (result != 0);
+    }
+
+    auto get_integer64_list(const ::std::int64_t** pp_list, int* p_count) const -> bool
+    {
+      if(is_replaying())
+      {
+        const trace_record* p_rec { my_trace->replay(trace_op::get_integer64_list) };
+
+        const bool result_get_is_ok { (p_rec != nullptr) && (p_rec->result != ::std::int64_t { INT8_C(0) }) };
+
+        if(result_get_is_ok)
+        {
+          *pp_list = p_rec->list.data();
+          *p_count = static_cast<int>(p_rec->list.size());
+        }
+
+        return result_get_is_ok;
+      }
+
+      ::std::int64_t* p_list { nullptr };
+
+      const int result { ::WSGetInteger64List(my_lnk_ptr, &p_list, p_count) };
+
+      *pp_list = p_list;
+
+      if(result != 0) { my_traffic.add_received(static_cast<::std::size_t>(*p_count) * sizeof(::std::int64_t)); }
+
+      if(my_trace != nullptr)
+      {
+        my_trace->record(trace_op::get_integer64_list, result, nullptr, ::std::size_t { UINT8_C(0) }, p_list, ((result != 0) ? static_cast<::std::size_t>(*p_count) : ::std::size_t { UINT8_C(0) }));
+      }
+
+      return (result != 0);
+    }
+
+    auto release_integer64_list(const ::std::int64_t* p_list, const int count) const -> void
+    {
+      if(!is_replaying())
+      {
+        ::WSReleaseInteger64List(my_lnk_ptr, const_cast<::std::int64_t*>(p_list), count); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+      }
+    }
+
+    auto get_utf8_string(const unsigned char** pp_str, int* p_len) const -> bool
+    {
+      if(is_replaying())
+      {
+        const trace_record* p_rec { my_trace->replay(trace_op::get_utf8_string) };
+
+        const bool result_get_is_ok { (p_rec != nullptr) && (p_rec->result != ::std::int64_t { INT8_C(0) }) };
+
+        if(result_get_is_ok)
+        {
+          *pp_str = reinterpret_cast<const unsigned char*>(p_rec->bytes.data()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+          *p_len  = static_cast<int>(p_rec->bytes.size());
+        }
+
+        return result_get_is_ok;
+      }
+
+      int chr_len_ws_get { };
+
+      const int result { ::WSGetUTF8String(my_lnk_ptr, pp_str, p_len, &chr_len_ws_get) };
+
+      if(result != 0) { my_traffic.add_received(static_cast<::std::size_t>(*p_len)); }
+
+      if(my_trace != nullptr)
+      {
+        my_trace->record(trace_op::get_utf8_string, result, reinterpret_cast<const char*>(*pp_str), ((result != 0) ? static_cast<::std::size_t>(*p_len) : ::std::size_t { UINT8_C(0) })); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      }
+
+      return (result != 0);
+    }
+
+    auto release_utf8_string(const unsigned char* p_str, const int len) const -> void
+    {
+      if(!is_replaying())
+      {
+        ::WSReleaseUTF8String(my_lnk_ptr, p_str, len);
+      }
+    }
+
+    auto put_command(const ::std::string& str_cmd, const bool suppress_output) const -> bool
+    {
+      const allocation_site site { "put_command" };
+
+      // The command is only copied (in one single allocation)
+      // when its output is suppressed.
+      ::std::string str_cmd_suppressed { };
+
+      if(suppress_output)
+      {
+        str_cmd_suppressed.reserve(str_cmd.size() + 1U);
+        str_cmd_suppressed.append(str_cmd).push_back(';');
+      }
+
+      const ::std::string& str_cmd_local { (suppress_output ? str_cmd_suppressed : str_cmd) };
+
+      const kernel_budget_type budget { kernel_budget() };
+
+      const timeline_scope scope_put { "put", "link" };
+
+      const latency_time_point put_start { latency_now() };
+
+      const bool
+        put_is_ok
+        {
+             put_function("EvaluatePacket", int { INT8_C(1) })
+          && put_budget_heads(budget)
+          && put_to_expression(str_cmd_local)
+          && put_budget_limits(budget)
+          && end_packet()
+        };
+
+      count_command(put_is_ok);
+
+      if(put_is_ok)
+      {
+        ++my_pending;
+
+        if(my_latency != nullptr)
+        {
+          const ::std::string::size_type pos_bracket { str_cmd.find('[') };
+
+          latency_put(((pos_bracket != ::std::string::npos) ? str_cmd.substr(::std::size_t { UINT8_C(0) }, pos_bracket) : ::std::string { "(none)" }), put_start);
+        }
+      }
+
+      return put_is_ok;
+    }
+
+    auto put_to_expression(const ::std::string& str_cmd) const -> bool
+    {
+      return
+        my_latency_kernel_timing ? (   put_function("ToExpression", int { INT8_C(3) })
+                                    && put_string(str_cmd)
+                                    && put_symbol("InputForm")
+                                    && put_symbol("AbsoluteTiming"))
+                                 : (   put_function("ToExpression", int { INT8_C(1) })
+                                    && put_string(str_cmd));
+    }
+
+    auto put_command(const expression& expr, const bool suppress_output) const -> bool
+    {
+      return put_expression(expr, suppress_output);
+    }
+
+    auto put_expression(const expression& expr, const bool suppress_output) const -> bool
+    {
+      // Suppressing the output is done with CompoundExpression[expr, Null].
+      const allocation_site site { "put_expression" };
+
+      const kernel_budget_type budget { kernel_budget() };
+
+      const timeline_scope scope_put { "put", "link" };
+
+      const latency_time_point put_start { latency_now() };
+
+      bool put_is_ok
+      {
+           put_function("EvaluatePacket", int { INT8_C(1) })
+        && ((!my_latency_kernel_timing) || put_function("AbsoluteTiming", int { INT8_C(1) }))
+        && ((!suppress_output) || put_function("CompoundExpression", int { INT8_C(2) }))
+        && put_budget_heads(budget)
+      };
+
+      for(const expression_token& tok : expr.tokens())
+      {
+        if(!put_is_ok)
+        {
+          break;
+        }
+
+        switch(tok.kind)
+        {
+          case expression_token_kind::function:
+            put_is_ok = put_function(tok.str.c_str(), static_cast<int>(tok.value));
+            break;
+
+          case expression_token_kind::integer:
+            put_is_ok = put_integer64(tok.value);
+            break;
+
+          case expression_token_kind::integer_digits:
+            put_is_ok = put_integer_digits(tok.str);
+            break;
+
+          case expression_token_kind::integer_limbs:
+            // The integer is put as FromDigits[{digits...}, 2^32], where the
+            // digits are sent in binary form as one single integer list.
+            put_is_ok =
+            (
+                 put_function("FromDigits", int { INT8_C(2) })
+              && put_integer64_list(tok.list)
+              && put_integer64(expression::limbs_radix())
+            );
+            break;
+
+          case expression_token_kind::string:
+            put_is_ok = put_string(tok.str);
+            break;
+
+          case expression_token_kind::symbol:
+          default:
+            put_is_ok = put_symbol(tok.str.c_str());
+            break;
+        }
+      }
+
+      put_is_ok = (put_is_ok && put_budget_limits(budget) && ((!suppress_output) || put_symbol("Null")) && end_packet());
+
+      count_command(put_is_ok);
+
+      if(put_is_ok)
+      {
+        ++my_pending;
+
+        if(my_latency != nullptr)
+        {
+          const bool has_head { (!expr.tokens().empty()) && (expr.tokens().front().kind == expression_token_kind::function) };
+
+          latency_put((has_head ? expr.tokens().front().str : ::std::string { "(none)" }), put_start);
+        }
+      }
+
+      return put_is_ok;
+    }
+
+    auto count_command(const bool put_is_ok) const noexcept -> void
+    {
+      if(!put_is_ok)
+      {
+        count_error();
+      }
+      else if(!is_replaying())
+      {
+        my_traffic.add_command();
+      }
+    }
+
+    auto count_packet(const int packet_id, const bool is_skipped) const noexcept -> void
+    {
+      if(!is_replaying())
+      {
+        my_traffic.add_packet(packet_id, is_skipped);
+      }
+    }
+
+    auto count_error() const noexcept -> void
+    {
+      if(!is_replaying())
+      {
+        my_traffic.add_error();
+      }
+    }
+
+    struct kernel_budget_type
+    {
+      ::std::int64_t time_ms { };
+      ::std::int64_t memory  { };
+    };
+
+    auto kernel_budget() const noexcept -> kernel_budget_type
+    {
+      return kernel_budget_type { my_time_budget_ms.load(), my_memory_budget.load() };
+    }
+
+    auto put_budget_heads(const kernel_budget_type& budget) const -> bool
+    {
+      // The evaluation is wrapped as TimeConstrained[MemoryConstrained[expr, bytes], seconds].
+      return
+      (
+           ((budget.time_ms == INT64_C(0)) || put_function("TimeConstrained",   int { INT8_C(2) }))
+        && ((budget.memory  == INT64_C(0)) || put_function("MemoryConstrained", int { INT8_C(2) }))
+      );
+    }
+
+    auto put_budget_limits(const kernel_budget_type& budget) const -> bool
+    {
+      // The time is put exactly, in seconds, as Rational[milliseconds, 1000].
+      return
+      (
+           ((budget.memory  == INT64_C(0)) || put_integer64(budget.memory))
+        && (   (budget.time_ms == INT64_C(0))
+            || (   put_function("Rational", int { INT8_C(2) })
+                && put_integer64(budget.time_ms)
+                && put_integer64(INT64_C(1000))))
+      );
+    }
+
+    auto recv_packets(packet_list_type* pkt_list, ::std::string* str_rsp) const -> bool
+    {
+      return recv_packets_into(pkt_list, [this, str_rsp]() -> bool { return get_string(str_rsp); });
+    }
+
+    template<typename ReturnGetterType>
+    auto recv_packets_into(packet_list_type* pkt_list, ReturnGetterType get_return) const -> bool
+    {
+      // Receive the packets resulting from one single evaluation. If no packet
+      // list is provided, then the packets before the ReturnPacket are skipped
+      // and the ReturnPacket is retrieved with the getter. Each packet is closed
+      // with new_packet(), so that the link is left in a known state even if the
+      // packet has more than one single component.
+
+      if(my_call_timed_out)
+      {
+        // The call has already timed out, and its evaluations have been drained.
+        return false;
+      }
+
+      my_latency_recv_start = latency_now();
+
+      for(bool is_return_packet { false }; !is_return_packet; )
+      {
+        if(!wait_ready())
+        {
+          abort_and_drain();
+
+          return false;
+        }
+
+        if(!recv_packet(pkt_list, get_return, &is_return_packet))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    template<typename ReturnGetterType>
+    auto recv_packet(packet_list_type* pkt_list, ReturnGetterType& get_return, bool* p_is_return_packet) const -> bool
+    {
+      // Receive one single packet. This is the step shared by the blocking
+      // receive above and by the non-blocking poll_response().
+
+      const allocation_site site { "recv_packet" };
+
+      const int next_packet_result { wait_packet() };
+
+      if(next_packet_result == int { INT8_C(0) })
+      {
+        count_error();
+
+        return false;
+      }
+
+      latency_first_packet();
+
+      const timeline_scope scope_get { "get", "link" };
+
+      const bool is_return_packet { (next_packet_result == return_packet_id()) };
+
+      if(is_return_packet && (my_pending != ::std::size_t { UINT8_C(0) }))
+      {
+        --my_pending;
+      }
+
+      const bool
+        is_kept
+        {
+              is_return_packet
+          || (   (pkt_list != nullptr)
+              && (   (next_packet_result == text_packet_id())
+                  || (next_packet_result == message_packet_id())))
+        };
+
+      count_packet(next_packet_result, !is_kept);
+
+      // With kernel timing, the ReturnPacket holds {seconds, result}.
+      bool get_packet_is_ok { (!is_return_packet) || (!my_latency_kernel_timing) || get_kernel_time() };
+
+      if(get_packet_is_ok && is_return_packet && (pkt_list == nullptr))
+      {
+        get_packet_is_ok = get_return();
+      }
+      else if(get_packet_is_ok && (pkt_list != nullptr) && is_kept)
+      {
+        packet_type pkt { next_packet_result, ::std::string { } };
+
+        get_packet_is_ok =
+          (next_packet_result == message_packet_id()) ? get_message(&pkt.str)
+                                                      : get_string(&pkt.str);
+
+        pkt_list->push_back(::std::move(pkt));
+      }
+
+      static_cast<void>(new_packet());
+
+      *p_is_return_packet = is_return_packet;
+
+      const bool result_recv_is_ok { get_packet_is_ok && (error() == detail::WSEOK) };
+
+      if(!result_recv_is_ok)
+      {
+        count_error();
+
+        // A response of an unexpected type is not the death of the kernel.
+        static_cast<void>(clear_recoverable_error());
+      }
+
+      if(is_return_packet)
+      {
+        latency_return(result_recv_is_ok);
+      }
+
+      return result_recv_is_ok;
     }
-  };
 
-  template<const char* PtrStrLocationMathLinkKernel> WSENV  mathematica_mathlink<PtrStrLocationMathLinkKernel>::env_ptr { nullptr };
-  template<const char* PtrStrLocationMathLinkKernel> WSLINK mathematica_mathlink<PtrStrLocationMathLinkKernel>::lnk_ptr { nullptr };
+    auto wait_packet() const -> int
+    {
+      // The wait for the next packet includes the evaluation in the kernel.
+
+      const timeline_scope scope_wait { "wait", "link" };
+
+      return next_packet();
+    }
+
+    auto latency_now() const -> latency_time_point
+    {
+      return ((my_latency != nullptr) ? ::std::chrono::steady_clock::now() : latency_time_point { });
+    }
+
+    static auto latency_ns(const latency_time_point start, const latency_time_point stop) noexcept -> ::std::uint64_t
+    {
+      return ((stop > start) ? static_cast<::std::uint64_t>(::std::chrono::duration_cast<::std::chrono::nanoseconds>(stop - start).count()) : ::std::uint64_t { UINT8_C(0) });
+    }
+
+    auto latency_put(const ::std::string& str_head, const latency_time_point put_start) const -> void
+    {
+      // Record the put phase and keep the sample until the command returns.
+      // The histograms of the last head are cached, which spares the lookup
+      // for runs of commands having the same head.
+
+      if((my_latency_last_phases == nullptr) || (str_head != my_latency_last_head))
+      {
+        my_latency_last_head   = str_head;
+        my_latency_last_phases = &my_latency->phases(str_head);
+      }
+
+      const latency_time_point put_end { ::std::chrono::steady_clock::now() };
+
+      my_latency_last_phases->put.record(latency_ns(put_start, put_end));
+
+      my_latency_samples.push_back(latency_sample_type { my_latency_last_phases, put_start, put_end, latency_time_point { }, false, ::std::uint64_t { UINT8_C(0) } });
+    }
+
+    auto get_kernel_time() const -> bool
+    {
+      // Read the head List[seconds, result] and the seconds, leaving the result to be read.
+
+      int argc { };
+
+      double seconds { };
+
+      const bool result_get_is_ok { test_head("List", &argc) && (argc == int { INT8_C(2) }) && get_real64(&seconds) };
+
+      if(result_get_is_ok && (!my_latency_samples.empty()))
+      {
+        my_latency_samples.front().kernel_ns = static_cast<::std::uint64_t>((::std::max)(seconds, 0.0) * 1.0E9);
+      }
+
+      return result_get_is_ok;
+    }
+
+    auto latency_first_packet() const -> void
+    {
+      if((my_latency != nullptr) && (!my_latency_samples.empty()) && (!my_latency_samples.front().has_first_packet))
+      {
+        my_latency_samples.front().first_packet     = ::std::chrono::steady_clock::now();
+        my_latency_samples.front().has_first_packet = true;
+      }
+    }
+
+    auto latency_return(const bool result_recv_is_ok) const -> void
+    {
+      // The wait starts when the command has been put, or when we started to
+      // receive it, whichever is later. Failed commands are not recorded.
+
+      if((my_latency != nullptr) && (!my_latency_samples.empty()))
+      {
+        const latency_sample_type& sample { my_latency_samples.front() };
+
+        if(result_recv_is_ok)
+        {
+          const latency_time_point wait_start { (::std::max)(sample.put_end, my_latency_recv_start) };
+
+          sample.p_phases->wait.record(latency_ns(wait_start, sample.first_packet));
+
+          const latency_time_point get_end { ::std::chrono::steady_clock::now() };
+
+          sample.p_phases->get  .record(latency_ns(sample.first_packet, get_end));
+          sample.p_phases->total.record(latency_ns(sample.put_start, get_end));
+
+          if(my_latency_kernel_timing)
+          {
+            sample.p_phases->kernel.record(sample.kernel_ns);
+          }
+        }
+
+        my_latency_samples.pop_front();
+      }
+    }
+
+    auto get_value(::std::string* p_value) const -> bool { return get_string(p_value); }
+
+    auto get_value(::std::int64_t* p_value) const -> bool { return get_integer64(p_value); }
+
+    auto get_value(double* p_value) const -> bool { return get_real64(p_value); }
+
+    auto get_value(bool* p_value) const -> bool
+    {
+      const char* p_str_sym_ws_get { nullptr };
+
+      bool result_get_symbol_is_ok { get_symbol(&p_str_sym_ws_get) };
+
+      if(result_get_symbol_is_ok)
+      {
+        const ::std::string str_sym { p_str_sym_ws_get };
+
+        release_symbol(p_str_sym_ws_get);
+
+        *p_value = (str_sym == "True");
+
+        result_get_symbol_is_ok = ((*p_value) || (str_sym == "False"));
+      }
+
+      return result_get_symbol_is_ok;
+    }
+
+    template<typename LimbIterator>
+    auto get_limbs(LimbIterator first, LimbIterator last) const -> bool
+    {
+      // Read the base-2^32 digits (most significant first)
+      // and distribute them into the limbs (least significant first).
+
+      using limb_type = typename ::std::iterator_traits<LimbIterator>::value_type;
+
+      constexpr unsigned limb_bits { static_cast<unsigned>(::std::numeric_limits<limb_type>::digits) };
+
+      const ::std::int64_t* p_digits { nullptr };
+
+      int digit_count { };
+
+      if(!get_integer64_list(&p_digits, &digit_count))
+      {
+        return false;
+      }
+
+      bool result_fits_is_ok { true };
+
+      ::std::uint64_t accumulator      { };
+      unsigned        accumulator_bits { };
+
+      for(int index { digit_count - 1 }; index >= 0; --index)
+      {
+        accumulator |= static_cast<::std::uint64_t>(static_cast<::std::uint64_t>(static_cast<::std::uint32_t>(p_digits[index])) << accumulator_bits); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        accumulator_bits += unsigned { UINT8_C(32) };
+
+        while(accumulator_bits >= limb_bits)
+        {
+          if(first == last)
+          {
+            result_fits_is_ok = (result_fits_is_ok && (accumulator == ::std::uint64_t { UINT8_C(0) }));
+          }
+          else
+          {
+            *first = static_cast<limb_type>(accumulator);
+
+            ++first;
+          }
+
+          accumulator = ((limb_bits < unsigned { UINT8_C(64) }) ? static_cast<::std::uint64_t>(accumulator >> (limb_bits % unsigned { UINT8_C(64) })) : ::std::uint64_t { UINT8_C(0) });
+
+          accumulator_bits -= limb_bits;
+        }
+      }
+
+      if(accumulator_bits != unsigned { UINT8_C(0) })
+      {
+        if(first == last)
+        {
+          result_fits_is_ok = (result_fits_is_ok && (accumulator == ::std::uint64_t { UINT8_C(0) }));
+        }
+        else
+        {
+          *first = static_cast<limb_type>(accumulator);
+
+          ++first;
+        }
+      }
+
+      for( ; first != last; ++first)
+      {
+        *first = limb_type { };
+      }
+
+      release_integer64_list(p_digits, digit_count);
+
+      return result_fits_is_ok;
+    }
+
+    auto get_message(::std::string* str_msg) const -> bool
+    {
+      // A MessagePacket has the form MessagePacket[symbol, "tag"].
+      const char* p_str_sym_ws_get { nullptr };
+
+      const bool result_get_symbol_is_ok { get_symbol(&p_str_sym_ws_get) };
+
+      if(!result_get_symbol_is_ok)
+      {
+        return false;
+      }
+
+      str_msg->assign(p_str_sym_ws_get);
+
+      release_symbol(p_str_sym_ws_get);
+
+      ::std::string str_tag { };
+
+      const bool result_get_tag_is_ok { get_string(&str_tag) };
+
+      if(result_get_tag_is_ok)
+      {
+        str_msg->append("::");
+        str_msg->append(str_tag);
+      }
+
+      return result_get_tag_is_ok;
+    }
+
+    auto get_string(::std::string* str_rsp) const -> bool
+    {
+      // The UTF-8 getter provides the length of the string,
+      // so the string is copied in one single pass.
+
+      const unsigned char* p_str_rsp_ws_get { nullptr };
+
+      int rsp_len_ws_get { };
+
+      const bool result_get_string_is_ok { get_utf8_string(&p_str_rsp_ws_get, &rsp_len_ws_get) };
+
+      if(result_get_string_is_ok)
+      {
+        if(str_rsp != nullptr)
+        {
+          str_rsp->assign(reinterpret_cast<const char*>(p_str_rsp_ws_get), static_cast<::std::size_t>(rsp_len_ws_get)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+
+        release_utf8_string(p_str_rsp_ws_get, rsp_len_ws_get);
+      }
+
+      return result_get_string_is_ok;
+    }
+
+    #if defined(MATHEMATICA_MATHLINK_HAS_STRING_VIEW)
+    template<typename VisitorType>
+    auto get_string_view(VisitorType& visitor) const -> bool
+    {
+      const unsigned char* p_str_rsp_ws_get { nullptr };
+
+      int rsp_len_ws_get { };
+
+      const bool result_get_string_is_ok { get_utf8_string(&p_str_rsp_ws_get, &rsp_len_ws_get) };
+
+      if(result_get_string_is_ok)
+      {
+        visitor(::std::string_view { reinterpret_cast<const char*>(p_str_rsp_ws_get), static_cast<::std::size_t>(rsp_len_ws_get) }); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        release_utf8_string(p_str_rsp_ws_get, rsp_len_ws_get);
+      }
+
+      return result_get_string_is_ok;
+    }
+    #endif
+
+    auto is_open() const noexcept -> bool
+    {
+      return ((my_env_ptr != nullptr) && (my_lnk_ptr != nullptr));
+    }
+
+    auto do_open(const mathematica_mathlink_options& options) const noexcept -> bool
+    {
+      // Create a list of constant arguments for opening the link.
+      ::std::vector<::std::string> const_args_strings { };
+
+      if(!options.name.empty())
+      {
+        const_args_strings.emplace_back("-linkname");
+        const_args_strings.push_back(options.name);
+      }
+
+      const_args_strings.emplace_back("-linkmode");
+      const_args_strings.emplace_back(mathematica_mathlink_options::str_mode(options.mode));
+
+      if(!options.protocol.empty())
+      {
+        const_args_strings.emplace_back("-linkprotocol");
+        const_args_strings.push_back(options.protocol);
+      }
+
+      // Create a list of non-constant character pointers for opening the link.
+      ::std::vector<::std::vector<char>> nonconst_args_strings { };
+      ::std::vector<char*>               nonconst_args_pointers { };
+
+      nonconst_args_strings.reserve(const_args_strings.size());
+
+      for(const ::std::string& str_arg : const_args_strings)
+      {
+        nonconst_args_strings.emplace_back(str_arg.size() + ::std::size_t { UINT8_C(1) }, '\0');
+
+        detail::strcpy_unsafe(nonconst_args_strings.back().data(), str_arg.c_str());
+
+        nonconst_args_pointers.push_back(nonconst_args_strings.back().data());
+      }
+
+      nonconst_args_pointers.push_back(nullptr);
+
+      // Open the link (launching the kernel, connecting to it or listening for it).
+      my_lnk_ptr = ::WSOpen(static_cast<int>(const_args_strings.size()), nonconst_args_pointers.data());
+
+      if(my_lnk_ptr == nullptr)
+      {
+        detail::release_environment();
+
+        my_env_ptr = nullptr;
+      }
+
+      return is_open();
+    }
+
+    static auto str_location_mathlink_kernel_default() -> ::std::string
+    {
+      // The environment override comes first, then the kernel location
+      // given as template parameter, then the discovered kernel.
+      // See mathematica_kernel_locator.h.
+
+      return kernel_locator::link_name(PtrStrLocationMathLinkKernel);
+    }
+
+    auto open(const mathematica_mathlink_options& options) const noexcept -> bool
+    {
+      bool result_do_open_is_ok { };
+
+      if(is_open())
+      {
+        result_do_open_is_ok = true;
+      }
+      else
+      {
+        my_env_ptr = detail::acquire_environment();
+
+        if(my_env_ptr != nullptr)
+        {
+          // Without a link name, a kernel is launched from its default location.
+          // Only listen mode can do without a link name (WSTP chooses one).
+
+          mathematica_mathlink_options options_resolved { options };
+
+          if(options_resolved.name.empty() && (options.mode == mathematica_mathlink_mode::launch))
+          {
+            options_resolved.name = str_location_mathlink_kernel_default();
+          }
+
+          if(options_resolved.name.empty() && (options.mode != mathematica_mathlink_mode::listen))
+          {
+            // Without any kernel to launch or to connect to, fail at once
+            // rather than waiting on an open that can not succeed.
+            detail::release_environment();
+
+            my_env_ptr = nullptr;
+          }
+          else
+          {
+            result_do_open_is_ok = do_open(options_resolved);
+          }
+        }
+      }
+
+      return result_do_open_is_ok;
+    }
+
+    auto close() const noexcept -> bool
+    {
+      const bool result_close_is_ok { is_open() };
+
+      if(my_lnk_ptr != nullptr)
+      {
+        static_cast<void>(::WSClose(my_lnk_ptr));
+
+        my_lnk_ptr = nullptr;
+      }
+
+      if(my_env_ptr != nullptr)
+      {
+        detail::release_environment();
+
+        my_env_ptr = nullptr;
+      }
+
+      return result_close_is_ok;
+    }
+  };
 
   } // namespace mathematica
 
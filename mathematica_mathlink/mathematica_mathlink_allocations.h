@@ -0,0 +1,298 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_MATHLINK_ALLOCATIONS_2026_10_16_H
+  #define MATHEMATICA_MATHLINK_ALLOCATIONS_2026_10_16_H
+
+  #include <array>
+  #include <atomic>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstdlib>
+  #include <cstring>
+  #include <iomanip>
+  #include <ios>
+  #include <new>
+  #include <ostream>
+
+  namespace mathematica {
+
+  class mathematica_mathlink_allocations
+  {
+  public:
+    // This is the mathematica_mathlink_allocations class. There is one single
+    // instance in the process (see instance()). While it is started, it counts
+    // the allocations (and their bytes) made through the global operator new,
+    // attributed to the call site active on the allocating thread (see
+    // allocation_site). Allocations made outside of any call site are counted
+    // as unattributed. The links mark their hot paths as call sites.
+
+    // The counting is driven by a replacement of the global operator new.
+    // Define MATHEMATICA_MATHLINK_ALLOCATION_HOOK before including this header
+    // in one single translation unit of the program to install it. Without
+    // the hook, nothing is ever counted.
+
+    // The counting itself never allocates. Up to max_sites call sites are
+    // counted apart. Further call sites are counted together as (other).
+
+    static constexpr ::std::size_t max_sites { ::std::size_t { UINT8_C(64) } };
+
+    static auto instance() noexcept -> mathematica_mathlink_allocations&
+    {
+      static mathematica_mathlink_allocations allocations { };
+
+      return allocations;
+    }
+
+    mathematica_mathlink_allocations(const mathematica_mathlink_allocations&) = delete;
+    mathematica_mathlink_allocations(mathematica_mathlink_allocations&&) noexcept = delete;
+
+    ~mathematica_mathlink_allocations() = default;
+
+    auto operator=(const mathematica_mathlink_allocations&) -> mathematica_mathlink_allocations& = delete;
+    auto operator=(mathematica_mathlink_allocations&&) noexcept -> mathematica_mathlink_allocations& = delete;
+
+    static auto current_site() noexcept -> const char*& { thread_local const char* p_site { nullptr }; return p_site; }
+
+    auto is_enabled() const noexcept -> bool { return my_enabled.load(::std::memory_order_relaxed); }
+
+    auto start() noexcept -> void
+    {
+      // Clear the counts and start counting.
+
+      for(site_type& site : my_sites)
+      {
+        site.count.store(0U, ::std::memory_order_relaxed);
+        site.bytes.store(0U, ::std::memory_order_relaxed);
+      }
+
+      my_unattributed.count.store(0U, ::std::memory_order_relaxed);
+      my_unattributed.bytes.store(0U, ::std::memory_order_relaxed);
+      my_other       .count.store(0U, ::std::memory_order_relaxed);
+      my_other       .bytes.store(0U, ::std::memory_order_relaxed);
+
+      my_enabled.store(true);
+    }
+
+    auto stop() noexcept -> void { my_enabled.store(false); }
+
+    auto record(const ::std::size_t size) noexcept -> void
+    {
+      if(is_enabled())
+      {
+        site_type& site { find(current_site()) };
+
+        site.count.fetch_add(1U, ::std::memory_order_relaxed);
+        site.bytes.fetch_add(static_cast<::std::uint64_t>(size), ::std::memory_order_relaxed);
+      }
+    }
+
+    auto count(const char* p_site) const noexcept -> ::std::uint64_t
+    {
+      // Get the count of allocations of the call site, null for the unattributed ones.
+
+      const site_type* p_found { lookup(p_site) };
+
+      return ((p_found != nullptr) ? p_found->count.load(::std::memory_order_relaxed) : ::std::uint64_t { UINT8_C(0) });
+    }
+
+    auto count_in_sites() const noexcept -> ::std::uint64_t
+    {
+      // Get the count of allocations of all of the call sites (without the unattributed ones).
+
+      ::std::uint64_t result { my_other.count.load(::std::memory_order_relaxed) };
+
+      for(const site_type& site : my_sites)
+      {
+        result += site.count.load(::std::memory_order_relaxed);
+      }
+
+      return result;
+    }
+
+    auto report(::std::ostream& os) const -> void
+    {
+      // Write one line per call site having allocated.
+
+      const ::std::ios_base::fmtflags flags { os.flags() };
+
+      os << ::std::left  << ::std::setw(32) << "site"
+         << ::std::right << ::std::setw(12) << "count"
+         << ::std::setw(16) << "bytes"
+         << '\n';
+
+      for(const site_type& site : my_sites)
+      {
+        const char* p_name { site.name.load(::std::memory_order_acquire) };
+
+        if((p_name != nullptr) && (site.count.load(::std::memory_order_relaxed) != ::std::uint64_t { UINT8_C(0) }))
+        {
+          report_site(os, p_name, site);
+        }
+      }
+
+      report_site(os, "(other)",        my_other);
+      report_site(os, "(unattributed)", my_unattributed);
+
+      static_cast<void>(os.flags(flags));
+    }
+
+  private:
+    struct site_type
+    {
+      ::std::atomic<const char*>     name  { nullptr };
+      ::std::atomic<::std::uint64_t> count { };
+      ::std::atomic<::std::uint64_t> bytes { };
+    };
+
+    ::std::atomic<bool>                  my_enabled      { false };
+    ::std::array<site_type, max_sites>   my_sites        { };
+    site_type                            my_unattributed { };
+    site_type                            my_other        { };
+
+    mathematica_mathlink_allocations() = default;
+
+    static auto same_site(const char* p_lhs, const char* p_rhs) noexcept -> bool
+    {
+      // The same string literal may have different addresses in different translation units.
+      return ((p_lhs == p_rhs) || (::std::strcmp(p_lhs, p_rhs) == 0));
+    }
+
+    auto find(const char* p_site) noexcept -> site_type&
+    {
+      // Find the slot of the call site, or claim a free one.
+
+      if(p_site == nullptr)
+      {
+        return my_unattributed;
+      }
+
+      for(site_type& site : my_sites)
+      {
+        const char* p_name { site.name.load(::std::memory_order_acquire) };
+
+        if(p_name == nullptr)
+        {
+          if(site.name.compare_exchange_strong(p_name, p_site, ::std::memory_order_acq_rel) || same_site(p_name, p_site))
+          {
+            return site;
+          }
+        }
+        else if(same_site(p_name, p_site))
+        {
+          return site;
+        }
+      }
+
+      return my_other;
+    }
+
+    auto lookup(const char* p_site) const noexcept -> const site_type*
+    {
+      if(p_site == nullptr)
+      {
+        return &my_unattributed;
+      }
+
+      for(const site_type& site : my_sites)
+      {
+        const char* p_name { site.name.load(::std::memory_order_acquire) };
+
+        if(p_name == nullptr)
+        {
+          break;
+        }
+
+        if(same_site(p_name, p_site))
+        {
+          return &site;
+        }
+      }
+
+      return nullptr;
+    }
+
+    static auto report_site(::std::ostream& os, const char* p_name, const site_type& site) -> void
+    {
+      os << ::std::left  << ::std::setw(32) << p_name
+         << ::std::right << ::std::setw(12) << site.count.load(::std::memory_order_relaxed)
+         << ::std::setw(16) << site.bytes.load(::std::memory_order_relaxed)
+         << '\n';
+    }
+  };
+
+  class allocation_site
+  {
+  public:
+    // Attribute the allocations of this thread to the call site during
+    // the lifetime of this object. The name must be a string literal.
+    // Call sites nest, the innermost one wins.
+
+    explicit allocation_site(const char* p_site) noexcept
+      : my_outer { mathematica_mathlink_allocations::current_site() }
+    {
+      mathematica_mathlink_allocations::current_site() = p_site;
+    }
+
+    allocation_site(const allocation_site&) = delete;
+    allocation_site(allocation_site&&) noexcept = delete;
+
+    ~allocation_site() { mathematica_mathlink_allocations::current_site() = my_outer; }
+
+    auto operator=(const allocation_site&) -> allocation_site& = delete;
+    auto operator=(allocation_site&&) noexcept -> allocation_site& = delete;
+
+  private:
+    const char* const my_outer;
+  };
+
+  } // namespace mathematica
+
+  #if defined(MATHEMATICA_MATHLINK_ALLOCATION_HOOK)
+
+  // These replace the global operator new and delete of the program.
+  // They must be defined in one single translation unit.
+
+  // GCC pairs the inlined free() of the replacement delete with the
+  // new-expressions of the library, and warns about a mismatch.
+  #if (defined(__GNUC__) && !defined(__clang__))
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+  #endif
+
+  auto operator new(::std::size_t size) -> void*
+  {
+    ::mathematica::mathematica_mathlink_allocations::instance().record(size);
+
+    void* p { ::std::malloc((size != 0U) ? size : ::std::size_t { UINT8_C(1) }) };
+
+    if(p == nullptr)
+    {
+      throw ::std::bad_alloc { };
+    }
+
+    return p;
+  }
+
+  auto operator new[](::std::size_t size) -> void*
+  {
+    return ::operator new(size);
+  }
+
+  auto operator delete(void* p) noexcept -> void { ::std::free(p); }
+  auto operator delete[](void* p) noexcept -> void { ::std::free(p); }
+
+  auto operator delete(void* p, ::std::size_t) noexcept -> void { ::std::free(p); }
+  auto operator delete[](void* p, ::std::size_t) noexcept -> void { ::std::free(p); }
+
+  #if (defined(__GNUC__) && !defined(__clang__))
+  #pragma GCC diagnostic pop
+  #endif
+
+  #endif // MATHEMATICA_MATHLINK_ALLOCATION_HOOK
+
+#endif // MATHEMATICA_MATHLINK_ALLOCATIONS_2026_10_16_H
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_MATHLINK_CACHE_2026_10_16_H
+  #define MATHEMATICA_MATHLINK_CACHE_2026_10_16_H
+
+  #include <mathematica_mathlink/mathematica_mathlink.h>
+
+  #include <cstddef>
+  #include <cstdint>
+  #include <list>
+  #include <mutex>
+  #include <string>
+  #include <unordered_map>
+  #include <utility>
+
+  namespace mathematica {
+
+  class mathematica_mathlink_cache : public mathematica_mathlink_base
+  {
+  public:
+    // This is the mathematica_mathlink_cache class. It decorates another
+    // link with a bounded, hashed cache of the least recently used responses,
+    // keyed on the command text. A repeated command is answered from the cache
+    // without a round trip to the kernel. Use this only for deterministic
+    // commands, whose response depends on nothing but the command text.
+
+    // Commands sent with suppressed output (having a null response pointer)
+    // are always forwarded, since they are sent for their side effects.
+
+    explicit mathematica_mathlink_cache(const mathematica_mathlink_base& lnk,
+                                        const ::std::size_t capacity = ::std::size_t { UINT16_C(4096) })
+      : my_link     { lnk },
+        my_capacity { capacity } { }
+
+    ~mathematica_mathlink_cache() noexcept override = default;
+
+    auto send_command(const ::std::string& str_cmd, ::std::string* str_rsp) const -> bool override
+    {
+      if(str_rsp == nullptr)
+      {
+        return my_link.send_command(str_cmd, str_rsp);
+      }
+
+      {
+        const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+        const auto itr_map = my_map.find(str_cmd);
+
+        if(itr_map != my_map.end())
+        {
+          // Move the entry to the front of the list (most recently used).
+          my_list.splice(my_list.begin(), my_list, itr_map->second);
+
+          *str_rsp = itr_map->second->second;
+
+          ++my_hits;
+
+          return true;
+        }
+
+        ++my_misses;
+      }
+
+      const bool result_send_is_ok { my_link.send_command(str_cmd, str_rsp) };
+
+      if(result_send_is_ok && (my_capacity != ::std::size_t { UINT8_C(0) }))
+      {
+        const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+        if(my_map.find(str_cmd) == my_map.end())
+        {
+          if(my_map.size() == my_capacity)
+          {
+            // Evict the least recently used entry at the back of the list.
+            static_cast<void>(my_map.erase(my_list.back().first));
+
+            my_list.pop_back();
+          }
+
+          my_list.emplace_front(str_cmd, *str_rsp);
+
+          static_cast<void>(my_map.emplace(str_cmd, my_list.begin()));
+        }
+      }
+
+      return result_send_is_ok;
+    }
+
+    auto hits    () const -> ::std::uint64_t { const ::std::lock_guard<::std::mutex> lock { my_mutex }; return my_hits; }
+    auto misses  () const -> ::std::uint64_t { const ::std::lock_guard<::std::mutex> lock { my_mutex }; return my_misses; }
+    auto size    () const -> ::std::size_t   { const ::std::lock_guard<::std::mutex> lock { my_mutex }; return my_map.size(); }
+    auto capacity() const noexcept -> ::std::size_t { return my_capacity; }
+
+    auto clear() -> void
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      my_map.clear();
+      my_list.clear();
+
+      my_hits   = ::std::uint64_t { UINT8_C(0) };
+      my_misses = ::std::uint64_t { UINT8_C(0) };
+    }
+
+  private:
+    using entry_type = ::std::pair<::std::string, ::std::string>;
+    using list_type  = ::std::list<entry_type>;
+    using map_type   = ::std::unordered_map<::std::string, typename list_type::iterator>;
+
+    const mathematica_mathlink_base& my_link;
+    const ::std::size_t              my_capacity;
+
+    mutable ::std::mutex    my_mutex  { };
+    mutable list_type       my_list   { };
+    mutable map_type        my_map    { };
+    mutable ::std::uint64_t my_hits   { };
+    mutable ::std::uint64_t my_misses { };
+
+    auto get_valid() const noexcept -> bool override
+    {
+      return my_link.is_valid();
+    }
+
+    auto get_traffic() const -> mathematica_mathlink_traffic override
+    {
+      return my_link.traffic();
+    }
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_MATHLINK_CACHE_2026_10_16_H
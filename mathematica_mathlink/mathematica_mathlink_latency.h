@@ -0,0 +1,291 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_MATHLINK_LATENCY_2026_10_16_H
+  #define MATHEMATICA_MATHLINK_LATENCY_2026_10_16_H
+
+  #include <algorithm>
+  #include <array>
+  #include <atomic>
+  #include <cstddef>
+  #include <cstdint>
+  #include <iomanip>
+  #include <ios>
+  #include <map>
+  #include <memory>
+  #include <mutex>
+  #include <ostream>
+  #include <string>
+  #include <vector>
+
+  namespace mathematica {
+
+  class latency_histogram
+  {
+  public:
+    // This is a log-linear (HDR-style) histogram of latencies in nanoseconds.
+    // Each power of two is split into 16 linear sub-buckets, so that any value
+    // is resolved to within about 6 percent. Values below 32 are exact.
+    // Recording is lock-free. The histogram can be read while it is recorded.
+
+    static constexpr unsigned      sub_bucket_bits  { unsigned { UINT8_C(5) } };
+    static constexpr ::std::size_t sub_bucket_half  { ::std::size_t { UINT8_C(1) } << (sub_bucket_bits - 1U) };
+    static constexpr ::std::size_t bucket_count     { ((64U - sub_bucket_bits) + 1U) * sub_bucket_half + sub_bucket_half };
+
+    latency_histogram() = default;
+
+    latency_histogram(const latency_histogram&) = delete;
+    latency_histogram(latency_histogram&&) noexcept = delete;
+
+    ~latency_histogram() = default;
+
+    auto operator=(const latency_histogram&) -> latency_histogram& = delete;
+    auto operator=(latency_histogram&&) noexcept -> latency_histogram& = delete;
+
+    auto record(const ::std::uint64_t value_ns) noexcept -> void
+    {
+      my_counts[bucket_index(value_ns)].fetch_add(1U, ::std::memory_order_relaxed);
+
+      my_count.fetch_add(1U, ::std::memory_order_relaxed);
+      my_sum  .fetch_add(value_ns, ::std::memory_order_relaxed);
+
+      ::std::uint64_t value_max { my_max.load(::std::memory_order_relaxed) };
+
+      while((value_ns > value_max) && (!my_max.compare_exchange_weak(value_max, value_ns, ::std::memory_order_relaxed))) { ; }
+    }
+
+    auto count() const noexcept -> ::std::uint64_t { return my_count.load(::std::memory_order_relaxed); }
+    auto max  () const noexcept -> ::std::uint64_t { return my_max  .load(::std::memory_order_relaxed); }
+
+    auto mean() const noexcept -> double
+    {
+      const ::std::uint64_t n { count() };
+
+      return ((n == 0U) ? 0.0 : static_cast<double>(my_sum.load(::std::memory_order_relaxed)) / static_cast<double>(n));
+    }
+
+    auto percentile(const double p) const noexcept -> ::std::uint64_t
+    {
+      // Get the value below which the given percentage (0 ... 100) of the
+      // recorded values lie. The value is the middle of its bucket.
+
+      const ::std::uint64_t n { count() };
+
+      if(n == 0U)
+      {
+        return ::std::uint64_t { UINT8_C(0) };
+      }
+
+      const double p_clamped { (::std::min)((::std::max)(p, 0.0), 100.0) };
+
+      const ::std::uint64_t rank { (::std::max)(static_cast<::std::uint64_t>((p_clamped / 100.0) * static_cast<double>(n) + 0.5), ::std::uint64_t { UINT8_C(1) }) };
+
+      ::std::uint64_t count_below { };
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < bucket_count; ++index)
+      {
+        count_below += my_counts[index].load(::std::memory_order_relaxed);
+
+        if(count_below >= rank)
+        {
+          return (::std::min)(bucket_middle(index), max());
+        }
+      }
+
+      return max();
+    }
+
+  private:
+    ::std::array<::std::atomic<::std::uint64_t>, bucket_count> my_counts { };
+
+    ::std::atomic<::std::uint64_t> my_count { };
+    ::std::atomic<::std::uint64_t> my_sum   { };
+    ::std::atomic<::std::uint64_t> my_max   { };
+
+    static auto msb(::std::uint64_t value) noexcept -> unsigned
+    {
+      unsigned result { };
+
+      while((value >>= 1U) != 0U) { ++result; }
+
+      return result;
+    }
+
+    static auto bucket_index(const ::std::uint64_t value) noexcept -> ::std::size_t
+    {
+      // Values below 2^bits are their own bucket. Above, the magnitude m
+      // selects a group of half as many buckets, and the bits just below
+      // the most significant bit select the bucket within the group.
+
+      if(value < (::std::uint64_t { UINT8_C(1) } << sub_bucket_bits))
+      {
+        return static_cast<::std::size_t>(value);
+      }
+
+      const unsigned magnitude { (msb(value) - sub_bucket_bits) + 1U };
+
+      return static_cast<::std::size_t>((static_cast<::std::uint64_t>(magnitude) * sub_bucket_half) + (value >> magnitude));
+    }
+
+    static auto bucket_middle(const ::std::size_t index) noexcept -> ::std::uint64_t
+    {
+      if(index < (::std::size_t { UINT8_C(1) } << sub_bucket_bits))
+      {
+        return static_cast<::std::uint64_t>(index);
+      }
+
+      const unsigned        magnitude { static_cast<unsigned>((index / sub_bucket_half) - 1U) };
+      const ::std::uint64_t sub       { static_cast<::std::uint64_t>(index - (static_cast<::std::size_t>(magnitude) * sub_bucket_half)) };
+
+      return ((sub << magnitude) + ((::std::uint64_t { UINT8_C(1) } << magnitude) / 2U));
+    }
+  };
+
+  struct latency_phases
+  {
+    // These are the phases of one single command: putting it on the link,
+    // waiting for its first packet (including the evaluation in the kernel)
+    // and getting the result (including the copy of the response). The total
+    // is the whole round trip. The kernel time is the evaluation time measured
+    // by the kernel itself, if kernel timing is enabled. The difference between
+    // the total and the kernel time is the overhead of the link layer.
+
+    latency_histogram put    { };
+    latency_histogram wait   { };
+    latency_histogram get    { };
+    latency_histogram total  { };
+    latency_histogram kernel { };
+  };
+
+  class mathematica_mathlink_latency
+  {
+  public:
+    // This is the mathematica_mathlink_latency class. It holds the latency
+    // histograms of the commands of one or more links, keyed by the head of
+    // the command (such as PrimeQ or GCD). Attach it to a link with
+    // set_latency(). The histograms can be read at runtime and reported.
+    // If a stream is given, the report is written to it upon destruction.
+
+    explicit mathematica_mathlink_latency(::std::ostream* p_report_at_exit = nullptr) noexcept
+      : my_report_at_exit { p_report_at_exit } { }
+
+    mathematica_mathlink_latency(const mathematica_mathlink_latency&) = delete;
+    mathematica_mathlink_latency(mathematica_mathlink_latency&&) noexcept = delete;
+
+    ~mathematica_mathlink_latency()
+    {
+      if(my_report_at_exit != nullptr)
+      {
+        report(*my_report_at_exit);
+      }
+    }
+
+    auto operator=(const mathematica_mathlink_latency&) -> mathematica_mathlink_latency& = delete;
+    auto operator=(mathematica_mathlink_latency&&) noexcept -> mathematica_mathlink_latency& = delete;
+
+    auto phases(const ::std::string& str_head) -> latency_phases&
+    {
+      // Get (or create) the histograms of the head. The reference stays valid
+      // for the lifetime of this object.
+
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      ::std::unique_ptr<latency_phases>& p_phases { my_phases[str_head] };
+
+      if(p_phases == nullptr)
+      {
+        p_phases.reset(new latency_phases { });
+      }
+
+      return *p_phases;
+    }
+
+    auto heads() const -> ::std::vector<::std::string>
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      ::std::vector<::std::string> result { };
+
+      for(const auto& entry : my_phases)
+      {
+        result.push_back(entry.first);
+      }
+
+      return result;
+    }
+
+    auto find(const ::std::string& str_head) const -> const latency_phases*
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      const auto it = my_phases.find(str_head);
+
+      return ((it != my_phases.cend()) ? it->second.get() : nullptr);
+    }
+
+    auto report(::std::ostream& os) const -> void
+    {
+      // Write one line per head and phase, with the times in microseconds.
+
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      const ::std::ios_base::fmtflags flags     { os.flags() };
+      const ::std::streamsize         precision { os.precision() };
+
+      os << ::std::left  << ::std::setw(24) << "head"
+         << ::std::setw(8) << "phase"
+         << ::std::right << ::std::setw(12) << "count"
+         << ::std::setw(12) << "mean_us"
+         << ::std::setw(12) << "p50_us"
+         << ::std::setw(12) << "p90_us"
+         << ::std::setw(12) << "p99_us"
+         << ::std::setw(12) << "max_us"
+         << '\n';
+
+      for(const auto& entry : my_phases)
+      {
+        report_phase(os, entry.first, "put",   entry.second->put);
+        report_phase(os, entry.first, "wait",  entry.second->wait);
+        report_phase(os, entry.first, "get",   entry.second->get);
+        report_phase(os, entry.first, "total", entry.second->total);
+
+        if(entry.second->kernel.count() != ::std::uint64_t { UINT8_C(0) })
+        {
+          report_phase(os, entry.first, "kernel", entry.second->kernel);
+        }
+      }
+
+      static_cast<void>(os.flags(flags));
+      static_cast<void>(os.precision(precision));
+    }
+
+  private:
+    ::std::ostream* const my_report_at_exit;
+
+    mutable ::std::mutex                                         my_mutex  { };
+    ::std::map<::std::string, ::std::unique_ptr<latency_phases>> my_phases { };
+
+    static auto report_phase(::std::ostream& os, const ::std::string& str_head, const char* p_str_phase, const latency_histogram& hist) -> void
+    {
+      const auto us = [](const double value_ns) -> double { return value_ns / 1000.0; };
+
+      os << ::std::left  << ::std::setw(24) << str_head
+         << ::std::setw(8) << p_str_phase
+         << ::std::right << ::std::setw(12) << hist.count()
+         << ::std::fixed << ::std::setprecision(2)
+         << ::std::setw(12) << us(hist.mean())
+         << ::std::setw(12) << us(static_cast<double>(hist.percentile(50.0)))
+         << ::std::setw(12) << us(static_cast<double>(hist.percentile(90.0)))
+         << ::std::setw(12) << us(static_cast<double>(hist.percentile(99.0)))
+         << ::std::setw(12) << us(static_cast<double>(hist.max()))
+         << '\n';
+    }
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_MATHLINK_LATENCY_2026_10_16_H
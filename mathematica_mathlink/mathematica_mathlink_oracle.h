@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_MATHLINK_ORACLE_2026_10_16_H
+  #define MATHEMATICA_MATHLINK_ORACLE_2026_10_16_H
+
+  #include <mathematica_mathlink/mathematica_mathlink.h>
+  #include <mathematica_mathlink/detail/mathematica_native_evaluator.h>
+
+  #include <atomic>
+  #include <cstdint>
+  #include <string>
+
+  namespace mathematica {
+
+  class mathematica_mathlink_oracle : public mathematica_mathlink_base
+  {
+  public:
+    // This is the mathematica_mathlink_oracle class. It is a backend that
+    // needs no kernel. It parses each command and evaluates it natively with
+    // detail::native_evaluator, which recognises the command forms used in the tests
+    // (PrimeQ, GCD, QuotientRemainder, IntegerString[FromDigits[...]], etc.).
+    // The response is the text of the resulting atom, just as it would be
+    // received from the kernel.
+
+    // A command that the oracle does not recognise (one that cannot be parsed,
+    // or one whose result is not an atom) fails. Alternatively, it is forwarded
+    // to a fallback link, such as a link to a real kernel, if one is given.
+
+    // The oracle runs at native speed. It can be used as a fast pre-screen
+    // in differential tests, keeping the kernel for sampled or disputed cases.
+
+    mathematica_mathlink_oracle() noexcept = default;
+
+    explicit mathematica_mathlink_oracle(const mathematica_mathlink_base& fallback) noexcept
+      : my_fallback { &fallback } { }
+
+    ~mathematica_mathlink_oracle() noexcept override = default;
+
+    auto send_command(const ::std::string& str_cmd, ::std::string* str_rsp) const -> bool override
+    {
+      if(answer(str_cmd, str_rsp))
+      {
+        ++my_answered;
+
+        return true;
+      }
+
+      if(my_fallback != nullptr)
+      {
+        ++my_forwarded;
+
+        return my_fallback->send_command(str_cmd, str_rsp);
+      }
+
+      ++my_declined;
+
+      return false;
+    }
+
+    static auto answer(const ::std::string& str_cmd, ::std::string* str_rsp) -> bool
+    {
+      // Answer the command natively, without any fallback.
+
+      detail::native_expression expr { };
+
+      if(!detail::native_parser::parse(str_cmd, &expr))
+      {
+        return false;
+      }
+
+      const detail::native_expression result { detail::native_evaluator { }.evaluate(expr) };
+
+      if(result.kind == detail::native_expression_kind::function)
+      {
+        return false;
+      }
+
+      if(str_rsp != nullptr)
+      {
+        *str_rsp = result.atom_text();
+      }
+
+      return true;
+    }
+
+    auto answered () const noexcept -> ::std::uint64_t { return my_answered.load(); }
+    auto forwarded() const noexcept -> ::std::uint64_t { return my_forwarded.load(); }
+    auto declined () const noexcept -> ::std::uint64_t { return my_declined.load(); }
+
+  private:
+    const mathematica_mathlink_base* const my_fallback { nullptr };
+
+    mutable ::std::atomic<::std::uint64_t> my_answered  { };
+    mutable ::std::atomic<::std::uint64_t> my_forwarded { };
+    mutable ::std::atomic<::std::uint64_t> my_declined  { };
+
+    auto get_valid() const noexcept -> bool override
+    {
+      // The oracle itself is always valid, even if the fallback is not.
+      return true;
+    }
+
+    auto get_traffic() const -> mathematica_mathlink_traffic override
+    {
+      // The oracle itself has no traffic. Without a fallback, there is none at all.
+      return ((my_fallback != nullptr) ? my_fallback->traffic() : mathematica_mathlink_traffic { });
+    }
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_MATHLINK_ORACLE_2026_10_16_H
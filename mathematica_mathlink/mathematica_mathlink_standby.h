@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_MATHLINK_STANDBY_2026_10_16_H
+  #define MATHEMATICA_MATHLINK_STANDBY_2026_10_16_H
+
+  #include <mathematica_mathlink/mathematica_mathlink.h>
+
+  #include <chrono>
+  #include <cstdint>
+  #include <future>
+  #include <memory>
+  #include <mutex>
+  #include <string>
+  #include <utility>
+
+  namespace mathematica {
+
+  template<typename LinkType = mathematica_mathlink<>>
+  class mathematica_mathlink_standby : public mathematica_mathlink_base
+  {
+  public:
+    // This is the mathematica_mathlink_standby class. It opens its link
+    // (launching the kernel) on a background thread, so that the constructor
+    // returns at once. The caller can generate its work in the meantime.
+    // The first command waits for the launch to complete, if needed.
+
+    // Optionally, one more kernel is kept warm on standby. When the kernel
+    // of the active link dies, the standby link takes over immediately and
+    // a new standby kernel is launched in the background. The command during
+    // which the kernel died fails, but the following commands find a live
+    // kernel without waiting for a restart. This hides kernel restarts
+    // in long soak runs.
+
+    // The active link is used exactly as the underlying link would be.
+    // Call share() on it (see link()) before using it from more than
+    // one thread.
+
+    using link_type = LinkType;
+
+    explicit mathematica_mathlink_standby(const mathematica_mathlink_options& options = mathematica_mathlink_options::from_environment(),
+                                          const bool keep_standby = true)
+      : my_options      { options },
+        my_keep_standby { keep_standby },
+        my_launch       { launch() },
+        my_standby      { my_keep_standby ? launch() : future_type { } } { }
+
+    ~mathematica_mathlink_standby() noexcept override = default;
+
+    auto send_command(const ::std::string& str_cmd, ::std::string* str_rsp) const -> bool override
+    {
+      const link_pointer_type p_link { link() };
+
+      const bool result_send_is_ok { p_link->send_command(str_cmd, str_rsp) };
+
+      if((!result_send_is_ok) && (!p_link->is_alive()))
+      {
+        replace(p_link);
+      }
+
+      return result_send_is_ok;
+    }
+
+    auto link() const -> ::std::shared_ptr<link_type>
+    {
+      // Get the active link, waiting for its launch if needed.
+
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      if(my_link == nullptr)
+      {
+        my_link = my_launch.get();
+
+        if(!my_link->is_valid())
+        {
+          // The very first launch failed. Use the standby link instead, if any.
+          swap_in_standby();
+        }
+      }
+
+      return my_link;
+    }
+
+    auto is_ready() const -> bool
+    {
+      // Check (without waiting) whether the active link has been launched.
+
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      return ((my_link != nullptr) || is_done(my_launch));
+    }
+
+    auto standby_is_ready() const -> bool
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      return is_done(my_standby);
+    }
+
+    auto restarts() const -> ::std::uint64_t
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      return my_restarts;
+    }
+
+  private:
+    using link_pointer_type = ::std::shared_ptr<link_type>;
+    using future_type       = ::std::future<link_pointer_type>;
+
+    const mathematica_mathlink_options my_options;
+    const bool                         my_keep_standby;
+
+    mutable ::std::mutex       my_mutex    { };
+    mutable future_type        my_launch;
+    mutable future_type        my_standby;
+    mutable link_pointer_type  my_link     { };
+    mutable ::std::uint64_t    my_restarts { };
+
+    auto launch() const -> future_type
+    {
+      const mathematica_mathlink_options options { my_options };
+
+      return ::std::async(::std::launch::async, [options]() { return ::std::make_shared<link_type>(options); });
+    }
+
+    static auto is_done(const future_type& ftr) -> bool
+    {
+      return (ftr.valid() && (ftr.wait_for(::std::chrono::seconds { 0 }) == ::std::future_status::ready));
+    }
+
+    auto swap_in_standby() const -> void
+    {
+      // Take over the standby link (waiting for it if it is still
+      // being launched) and launch a new standby link.
+
+      if(my_standby.valid())
+      {
+        my_link = my_standby.get();
+
+        my_standby = launch();
+
+        ++my_restarts;
+      }
+    }
+
+    auto replace(const link_pointer_type& p_link_dead) const -> void
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      if(my_link != p_link_dead)
+      {
+        // Another thread has already replaced the dead link.
+        return;
+      }
+
+      if(my_keep_standby)
+      {
+        swap_in_standby();
+      }
+      else
+      {
+        my_link = ::std::make_shared<link_type>(my_options);
+
+        ++my_restarts;
+      }
+    }
+
+    auto get_valid() const noexcept -> bool override
+    {
+      // This waits for the launch of the active link.
+
+      try
+      {
+        return link()->is_valid();
+      }
+      catch(...)
+      {
+        return false;
+      }
+    }
+
+    auto get_traffic() const -> mathematica_mathlink_traffic override
+    {
+      // This is the traffic of the active link (if it has been launched).
+
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      return ((my_link != nullptr) ? my_link->traffic() : mathematica_mathlink_traffic { });
+    }
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_MATHLINK_STANDBY_2026_10_16_H
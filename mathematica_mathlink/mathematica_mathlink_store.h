@@ -0,0 +1,524 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_MATHLINK_STORE_2026_10_16_H
+  #define MATHEMATICA_MATHLINK_STORE_2026_10_16_H
+
+  #include <mathematica_mathlink/mathematica_mathlink.h>
+
+  #include <array>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstring>
+  #include <fstream>
+  #include <memory>
+  #include <mutex>
+  #include <string>
+  #include <unordered_map>
+  #include <utility>
+
+  #if defined(_WIN32)
+  #if !defined(WIN32_LEAN_AND_MEAN)
+  #define WIN32_LEAN_AND_MEAN
+  #endif
+  #if !defined(NOMINMAX)
+  #define NOMINMAX
+  #endif
+  #include <windows.h>
+  #else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #endif
+
+  namespace mathematica {
+
+  namespace detail {
+
+  class mapped_file : private noncopyable
+  {
+  public:
+    // This is a read-only memory mapping of an entire file.
+
+    mapped_file() = default;
+
+    ~mapped_file() noexcept { unmap(); }
+
+    auto map(const ::std::string& str_path) -> bool
+    {
+      unmap();
+
+      #if defined(_WIN32)
+      const HANDLE h_file { ::CreateFileA(str_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+
+      if(h_file == INVALID_HANDLE_VALUE) { return false; }
+
+      LARGE_INTEGER file_size { };
+
+      bool result_map_is_ok { (::GetFileSizeEx(h_file, &file_size) != FALSE) };
+
+      if(result_map_is_ok && (file_size.QuadPart > 0))
+      {
+        const HANDLE h_map { ::CreateFileMappingA(h_file, nullptr, PAGE_READONLY, DWORD { 0U }, DWORD { 0U }, nullptr) };
+
+        result_map_is_ok = (h_map != nullptr);
+
+        if(result_map_is_ok)
+        {
+          my_data = static_cast<const char*>(::MapViewOfFile(h_map, FILE_MAP_READ, DWORD { 0U }, DWORD { 0U }, SIZE_T { 0U }));
+
+          static_cast<void>(::CloseHandle(h_map));
+
+          result_map_is_ok = (my_data != nullptr);
+
+          my_size = (result_map_is_ok ? static_cast<::std::size_t>(file_size.QuadPart) : ::std::size_t { UINT8_C(0) });
+        }
+      }
+
+      static_cast<void>(::CloseHandle(h_file));
+      #else
+      const int fd { ::open(str_path.c_str(), O_RDONLY) };
+
+      if(fd < 0) { return false; }
+
+      struct stat file_stat { };
+
+      bool result_map_is_ok { (::fstat(fd, &file_stat) == 0) };
+
+      if(result_map_is_ok && (file_stat.st_size > 0))
+      {
+        void* p_map { ::mmap(nullptr, static_cast<::std::size_t>(file_stat.st_size), PROT_READ, MAP_SHARED, fd, 0) };
+
+        result_map_is_ok = (p_map != MAP_FAILED); // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+
+        if(result_map_is_ok)
+        {
+          my_data = static_cast<const char*>(p_map);
+          my_size = static_cast<::std::size_t>(file_stat.st_size);
+        }
+      }
+
+      static_cast<void>(::close(fd));
+      #endif
+
+      return result_map_is_ok;
+    }
+
+    auto unmap() noexcept -> void
+    {
+      if(my_data != nullptr)
+      {
+        #if defined(_WIN32)
+        static_cast<void>(::UnmapViewOfFile(my_data));
+        #else
+        static_cast<void>(::munmap(const_cast<char*>(my_data), my_size)); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        #endif
+      }
+
+      my_data = nullptr;
+      my_size = ::std::size_t { UINT8_C(0) };
+    }
+
+    auto data() const noexcept -> const char*   { return my_data; }
+    auto size() const noexcept -> ::std::size_t { return my_size; }
+
+  private:
+    const char*   my_data { nullptr };
+    ::std::size_t my_size { };
+  };
+
+  inline auto fnv1a_hash(const ::std::string& str) noexcept -> ::std::uint64_t
+  {
+    ::std::uint64_t hash { UINT64_C(0xCBF29CE484222325) };
+
+    for(const char c : str)
+    {
+      hash ^= static_cast<::std::uint64_t>(static_cast<unsigned char>(c));
+      hash *= UINT64_C(0x100000001B3);
+    }
+
+    return hash;
+  }
+
+  } // namespace detail
+
+  template<typename LinkType = mathematica_mathlink<>>
+  class mathematica_mathlink_store : public mathematica_mathlink_base
+  {
+  public:
+    // This is the mathematica_mathlink_store class. It keeps the responses
+    // of the kernel in a persistent, append-only store on disk, keyed on
+    // the hash of the command text. Commands already answered in this run
+    // or in a previous run are served from a memory mapping of the store.
+    // The link (and its kernel) is only launched on the first command
+    // that is not found in the store. So a replay run in which all of
+    // the commands are found does not need a Mathematica installation.
+
+    // The store consists of two files. The data file (at the given path)
+    // holds the records, each one being the hash, the command and the
+    // response. The index file (with the extension .idx appended) holds
+    // the hash and the offset of each record, so that the store can be
+    // opened without scanning the data file. Records that are missing
+    // from the index (for instance after an interrupted run) are
+    // recovered from the data file when the store is opened.
+
+    // Use the store only for deterministic commands. A store file must not
+    // be written by more than one process at the same time.
+
+    using link_type = LinkType;
+
+    explicit mathematica_mathlink_store(::std::string str_path)
+      : my_data_path  { ::std::move(str_path) },
+        my_index_path { my_data_path + ".idx" },
+        my_valid      { open() } { }
+
+    ~mathematica_mathlink_store() noexcept override = default;
+
+    auto send_command(const ::std::string& str_cmd, ::std::string* str_rsp) const -> bool override
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      if(str_rsp == nullptr)
+      {
+        // Commands with suppressed output are sent for their
+        // side effects. These are always sent to the kernel.
+
+        return get_link().send_command(str_cmd, str_rsp);
+      }
+
+      if(find(str_cmd, str_rsp))
+      {
+        ++my_hits;
+
+        return true;
+      }
+
+      ++my_misses;
+
+      const bool result_send_is_ok { get_link().send_command(str_cmd, str_rsp) };
+
+      // A response that can not be stored is still a valid response.
+      // The failure is counted apart (see store_errors()).
+      if(result_send_is_ok && (!append(str_cmd, *str_rsp)))
+      {
+        ++my_store_errors;
+      }
+
+      return result_send_is_ok;
+    }
+
+    auto hits  () const -> ::std::uint64_t { const ::std::lock_guard<::std::mutex> lock { my_mutex }; return my_hits; }
+    auto misses() const -> ::std::uint64_t { const ::std::lock_guard<::std::mutex> lock { my_mutex }; return my_misses; }
+    auto size  () const -> ::std::size_t   { const ::std::lock_guard<::std::mutex> lock { my_mutex }; return my_index.size(); }
+
+    // The store is valid if its files could be opened. The responses that
+    // could not be stored (for instance in an invalid store) are counted
+    // as store errors. Neither one affects the responses of the kernel.
+    auto store_is_valid() const noexcept -> bool { return my_valid; }
+
+    auto store_errors() const -> ::std::uint64_t { const ::std::lock_guard<::std::mutex> lock { my_mutex }; return my_store_errors; }
+
+    auto link_is_launched() const -> bool { const ::std::lock_guard<::std::mutex> lock { my_mutex }; return (my_link != nullptr); }
+
+  private:
+    static constexpr ::std::size_t header_size       { ::std::size_t { UINT8_C(16) } };
+    static constexpr ::std::size_t record_head_size  { ::std::size_t { UINT8_C(16) } };
+    static constexpr ::std::size_t index_entry_size  { ::std::size_t { UINT8_C(16) } };
+
+    using header_type = ::std::array<char, header_size>;
+    using index_type  = ::std::unordered_multimap<::std::uint64_t, ::std::uint64_t>;
+
+    const ::std::string my_data_path;
+    const ::std::string my_index_path;
+
+    mutable ::std::mutex                 my_mutex        { };
+    mutable ::std::fstream               my_data_file    { };
+    mutable ::std::fstream               my_index_file   { };
+    mutable detail::mapped_file          my_data_map     { };
+    mutable index_type                   my_index        { };
+    mutable ::std::uint64_t              my_data_end     { };
+    mutable ::std::uint64_t              my_index_end    { };
+    mutable ::std::uint64_t              my_hits         { };
+    mutable ::std::uint64_t              my_misses       { };
+    mutable ::std::uint64_t              my_store_errors { };
+    mutable ::std::unique_ptr<link_type> my_link         { };
+
+    const bool my_valid;
+
+    static auto data_magic () noexcept -> header_type { return header_type { 'M', 'M', 'L', 'S', 'T', 'O', 'R', 'E', '\1' }; }
+    static auto index_magic() noexcept -> header_type { return header_type { 'M', 'M', 'L', 'I', 'N', 'D', 'E', 'X', '\1' }; }
+
+    static auto padded(const ::std::uint64_t n) noexcept -> ::std::uint64_t
+    {
+      return static_cast<::std::uint64_t>((n + UINT64_C(7)) & static_cast<::std::uint64_t>(~UINT64_C(7)));
+    }
+
+    template<typename UnsignedType>
+    static auto load(const char* p) noexcept -> UnsignedType
+    {
+      UnsignedType value { };
+
+      ::std::memcpy(&value, p, sizeof(UnsignedType));
+
+      return value;
+    }
+
+    auto get_valid() const noexcept -> bool override
+    {
+      // The link is created lazily under the mutex, so it is read under the mutex.
+
+      const ::std::lock_guard<::std::mutex> lock { my_mutex };
+
+      return ((my_link == nullptr) || my_link->is_valid());
+    }
+
+    auto get_link() const -> const link_type&
+    {
+      if(my_link == nullptr)
+      {
+        my_link.reset(new link_type { });
+      }
+
+      return *my_link;
+    }
+
+    static auto open_file(::std::fstream& file, const ::std::string& str_path, const header_type& magic) -> bool
+    {
+      file.open(str_path, ::std::ios::in | ::std::ios::out | ::std::ios::binary);
+
+      if(!file.is_open())
+      {
+        // Create the file and write its header.
+        file.clear();
+        file.open(str_path, ::std::ios::in | ::std::ios::out | ::std::ios::binary | ::std::ios::trunc);
+
+        static_cast<void>(file.write(magic.data(), static_cast<::std::streamsize>(magic.size())));
+        static_cast<void>(file.flush());
+      }
+
+      header_type header { };
+
+      static_cast<void>(file.seekg(0));
+      static_cast<void>(file.read(header.data(), static_cast<::std::streamsize>(header.size())));
+
+      return (file.good() && (header == magic));
+    }
+
+    auto record_is_valid(const ::std::uint64_t offset, ::std::uint64_t* p_next) const -> bool
+    {
+      // A record is valid if it lies entirely within the data
+      // file and if its hash matches the hash of its command.
+
+      const ::std::uint64_t map_size { static_cast<::std::uint64_t>(my_data_map.size()) };
+
+      if((offset < header_size) || ((offset + record_head_size) > map_size))
+      {
+        return false;
+      }
+
+      const char* p_rec { my_data_map.data() + offset };
+
+      const ::std::uint64_t hash     { load<::std::uint64_t>(p_rec) };
+      const ::std::uint32_t cmd_size { load<::std::uint32_t>(p_rec + 8U) };
+      const ::std::uint32_t rsp_size { load<::std::uint32_t>(p_rec + 12U) };
+
+      const ::std::uint64_t next { offset + padded(record_head_size + cmd_size + rsp_size) };
+
+      if((next > map_size) || (next < offset))
+      {
+        return false;
+      }
+
+      if(hash != detail::fnv1a_hash(::std::string { p_rec + record_head_size, cmd_size }))
+      {
+        return false;
+      }
+
+      *p_next = next;
+
+      return true;
+    }
+
+    auto open() -> bool
+    {
+      if(!(   open_file(my_data_file,  my_data_path,  data_magic())
+           && open_file(my_index_file, my_index_path, index_magic())))
+      {
+        return false;
+      }
+
+      static_cast<void>(my_data_map.map(my_data_path));
+
+      my_data_end  = header_size;
+      my_index_end = header_size;
+
+      // Load the index entries, as long as they refer to consecutive valid records.
+      {
+        detail::mapped_file index_map { };
+
+        static_cast<void>(index_map.map(my_index_path));
+
+        for( ; (my_index_end + index_entry_size) <= index_map.size(); my_index_end += index_entry_size)
+        {
+          const char* p_entry { index_map.data() + my_index_end };
+
+          const ::std::uint64_t hash   { load<::std::uint64_t>(p_entry) };
+          const ::std::uint64_t offset { load<::std::uint64_t>(p_entry + 8U) };
+
+          ::std::uint64_t next { };
+
+          if(   (offset != my_data_end)
+             || (!record_is_valid(offset, &next))
+             || (load<::std::uint64_t>(my_data_map.data() + offset) != hash))
+          {
+            break;
+          }
+
+          static_cast<void>(my_index.emplace(hash, offset));
+
+          my_data_end = next;
+        }
+      }
+
+      // Recover the records that were written but not indexed.
+      for(::std::uint64_t next { }; record_is_valid(my_data_end, &next); my_data_end = next)
+      {
+        if(!append_index(load<::std::uint64_t>(my_data_map.data() + my_data_end), my_data_end))
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    auto find(const ::std::string& str_cmd, ::std::string* str_rsp) const -> bool
+    {
+      const ::std::uint64_t hash { detail::fnv1a_hash(str_cmd) };
+
+      const auto range = my_index.equal_range(hash);
+
+      if(   (range.first != range.second)
+         && (static_cast<::std::uint64_t>(my_data_map.size()) < my_data_end))
+      {
+        // Records were appended since the data file was last mapped.
+        // If the data file can not be mapped again (for instance because
+        // it has been renamed or deleted), the command is not found.
+        if(!my_data_map.map(my_data_path))
+        {
+          return false;
+        }
+      }
+
+      const ::std::uint64_t map_size { static_cast<::std::uint64_t>(my_data_map.size()) };
+
+      for(auto itr = range.first; itr != range.second; ++itr)
+      {
+        // As in record_is_valid(), the record must lie entirely within the data file.
+
+        const ::std::uint64_t offset { itr->second };
+
+        if((offset < header_size) || (offset > map_size) || ((map_size - offset) < record_head_size))
+        {
+          continue;
+        }
+
+        const char* p_rec { my_data_map.data() + offset };
+
+        const ::std::uint32_t cmd_size { load<::std::uint32_t>(p_rec + 8U) };
+        const ::std::uint32_t rsp_size { load<::std::uint32_t>(p_rec + 12U) };
+
+        if((map_size - offset - record_head_size) < (static_cast<::std::uint64_t>(cmd_size) + rsp_size))
+        {
+          continue;
+        }
+
+        // Check the command itself, in case of a collision of the hashes.
+        if(   (cmd_size == str_cmd.size())
+           && (::std::memcmp(p_rec + record_head_size, str_cmd.data(), cmd_size) == 0))
+        {
+          str_rsp->assign(p_rec + record_head_size + cmd_size, rsp_size);
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    auto append_index(const ::std::uint64_t hash, const ::std::uint64_t offset) const -> bool
+    {
+      ::std::array<char, index_entry_size> entry { };
+
+      ::std::memcpy(entry.data(),      &hash,   sizeof(hash));
+      ::std::memcpy(entry.data() + 8U, &offset, sizeof(offset));
+
+      static_cast<void>(my_index_file.seekp(static_cast<::std::streamoff>(my_index_end)));
+      static_cast<void>(my_index_file.write(entry.data(), static_cast<::std::streamsize>(entry.size())));
+      static_cast<void>(my_index_file.flush());
+
+      if(!my_index_file.good())
+      {
+        return false;
+      }
+
+      static_cast<void>(my_index.emplace(hash, offset));
+
+      my_index_end += index_entry_size;
+
+      return true;
+    }
+
+    auto append(const ::std::string& str_cmd, const ::std::string& str_rsp) const -> bool
+    {
+      if(   (!my_valid)
+         || (str_cmd.size() > static_cast<::std::size_t>(UINT32_MAX))
+         || (str_rsp.size() > static_cast<::std::size_t>(UINT32_MAX)))
+      {
+        return false;
+      }
+
+      const ::std::uint64_t hash     { detail::fnv1a_hash(str_cmd) };
+      const ::std::uint32_t cmd_size { static_cast<::std::uint32_t>(str_cmd.size()) };
+      const ::std::uint32_t rsp_size { static_cast<::std::uint32_t>(str_rsp.size()) };
+
+      ::std::array<char, record_head_size> record_head { };
+
+      ::std::memcpy(record_head.data(),       &hash,     sizeof(hash));
+      ::std::memcpy(record_head.data() + 8U,  &cmd_size, sizeof(cmd_size));
+      ::std::memcpy(record_head.data() + 12U, &rsp_size, sizeof(rsp_size));
+
+      const ::std::uint64_t record_size { record_head_size + cmd_size + rsp_size };
+
+      const ::std::array<char, 8U> padding { };
+
+      // Write the record first and its index entry afterwards,
+      // so that an interrupted write never leaves a dangling entry.
+      static_cast<void>(my_data_file.seekp(static_cast<::std::streamoff>(my_data_end)));
+      static_cast<void>(my_data_file.write(record_head.data(), static_cast<::std::streamsize>(record_head.size())));
+      static_cast<void>(my_data_file.write(str_cmd.data(), static_cast<::std::streamsize>(cmd_size)));
+      static_cast<void>(my_data_file.write(str_rsp.data(), static_cast<::std::streamsize>(rsp_size)));
+      static_cast<void>(my_data_file.write(padding.data(), static_cast<::std::streamsize>(padded(record_size) - record_size)));
+      static_cast<void>(my_data_file.flush());
+
+      if(!my_data_file.good())
+      {
+        return false;
+      }
+
+      const ::std::uint64_t offset { my_data_end };
+
+      my_data_end += padded(record_size);
+
+      return append_index(hash, offset);
+    }
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_MATHLINK_STORE_2026_10_16_H
@@ -0,0 +1,338 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_MATHLINK_TIMELINE_2026_10_16_H
+  #define MATHEMATICA_MATHLINK_TIMELINE_2026_10_16_H
+
+  #include <atomic>
+  #include <chrono>
+  #include <cstddef>
+  #include <cstdint>
+  #include <fstream>
+  #include <iomanip>
+  #include <memory>
+  #include <mutex>
+  #include <string>
+  #include <vector>
+
+  namespace mathematica {
+
+  struct timeline_event
+  {
+    // One single event. The name and the category must be string literals
+    // (or otherwise outlive the timeline), since only their pointers are kept.
+    // An event without duration is an instant event.
+
+    const char*    name     { nullptr };
+    const char*    category { nullptr };
+    ::std::int64_t start_ns { };
+    ::std::int64_t dur_ns   { };
+    bool           instant  { false };
+  };
+
+  class timeline_ring
+  {
+  public:
+    // This is a lock-free, bounded single-producer single-consumer ring of
+    // events. The thread owning the ring pushes, the flush pops. When the
+    // ring is full, the event is dropped and counted rather than blocking.
+
+    static constexpr ::std::size_t capacity { ::std::size_t { UINT32_C(0x10000) } };
+
+    explicit timeline_ring(const ::std::uint32_t thread_id) : my_thread_id { thread_id } { }
+
+    timeline_ring(const timeline_ring&) = delete;
+    timeline_ring(timeline_ring&&) noexcept = delete;
+
+    ~timeline_ring() = default;
+
+    auto operator=(const timeline_ring&) -> timeline_ring& = delete;
+    auto operator=(timeline_ring&&) noexcept -> timeline_ring& = delete;
+
+    auto thread_id() const noexcept -> ::std::uint32_t { return my_thread_id; }
+    auto dropped  () const noexcept -> ::std::uint64_t { return my_dropped.load(::std::memory_order_relaxed); }
+
+    auto push(const timeline_event& event) noexcept -> void
+    {
+      const ::std::size_t head { my_head.load(::std::memory_order_relaxed) };
+
+      if((head - my_tail.load(::std::memory_order_acquire)) == capacity)
+      {
+        my_dropped.fetch_add(1U, ::std::memory_order_relaxed);
+
+        return;
+      }
+
+      my_events[head % capacity] = event;
+
+      my_head.store(head + 1U, ::std::memory_order_release);
+    }
+
+    auto try_pop(timeline_event* p_event) noexcept -> bool
+    {
+      const ::std::size_t tail { my_tail.load(::std::memory_order_relaxed) };
+
+      if(tail == my_head.load(::std::memory_order_acquire))
+      {
+        return false;
+      }
+
+      *p_event = my_events[tail % capacity];
+
+      my_tail.store(tail + 1U, ::std::memory_order_release);
+
+      return true;
+    }
+
+  private:
+    const ::std::uint32_t          my_thread_id;
+    ::std::vector<timeline_event>  my_events  { ::std::vector<timeline_event>(capacity) };
+    ::std::atomic<::std::size_t>   my_head    { };
+    ::std::atomic<::std::size_t>   my_tail    { };
+    ::std::atomic<::std::uint64_t> my_dropped { };
+  };
+
+  class mathematica_mathlink_timeline
+  {
+  public:
+    // This is the mathematica_mathlink_timeline class. There is one single
+    // timeline in the process (see instance()). Once started, the links and
+    // the test drivers record their activity (command submit, put, kernel wait,
+    // response get, local compute) as events into a ring owned by the recording
+    // thread. Recording is lock-free and costs one atomic load when the timeline
+    // is not started. flush() writes the recorded events into a file in the
+    // Chrome trace event format (JSON), which Perfetto and chrome://tracing open.
+    // Flush regularly during long runs, since full rings drop their events.
+
+    using clock_type      = ::std::chrono::steady_clock;
+    using time_point_type = clock_type::time_point;
+
+    static auto instance() -> mathematica_mathlink_timeline&
+    {
+      static mathematica_mathlink_timeline timeline { };
+
+      return timeline;
+    }
+
+    mathematica_mathlink_timeline(const mathematica_mathlink_timeline&) = delete;
+    mathematica_mathlink_timeline(mathematica_mathlink_timeline&&) noexcept = delete;
+
+    ~mathematica_mathlink_timeline() { stop(); }
+
+    auto operator=(const mathematica_mathlink_timeline&) -> mathematica_mathlink_timeline& = delete;
+    auto operator=(mathematica_mathlink_timeline&&) noexcept -> mathematica_mathlink_timeline& = delete;
+
+    // The acquire pairs with the store in start(), so that a thread
+    // seeing the timeline enabled also sees its origin.
+    auto is_enabled() const noexcept -> bool { return my_enabled.load(::std::memory_order_acquire); }
+
+    auto start(const ::std::string& str_path) -> bool
+    {
+      // Open the trace file and start recording.
+
+      const ::std::lock_guard<::std::mutex> lock { my_file_mutex };
+
+      if(my_file.is_open())
+      {
+        return false;
+      }
+
+      my_file.open(str_path, ::std::ios::out | ::std::ios::trunc);
+
+      if(!my_file.is_open())
+      {
+        return false;
+      }
+
+      my_file << "[\n";
+
+      my_first_event = true;
+      my_origin      = clock_type::now();
+
+      my_enabled.store(true, ::std::memory_order_release);
+
+      return true;
+    }
+
+    auto stop() -> void
+    {
+      // Stop recording, write the events that are left and close the trace file.
+
+      my_enabled.store(false);
+
+      const ::std::lock_guard<::std::mutex> lock { my_file_mutex };
+
+      if(my_file.is_open())
+      {
+        flush_locked();
+
+        my_file << "\n]\n";
+
+        my_file.close();
+      }
+    }
+
+    auto flush() -> void
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_file_mutex };
+
+      if(my_file.is_open())
+      {
+        flush_locked();
+      }
+    }
+
+    auto dropped() const -> ::std::uint64_t
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_rings_mutex };
+
+      ::std::uint64_t result { };
+
+      for(const auto& p_ring : my_rings)
+      {
+        result += p_ring->dropped();
+      }
+
+      return result;
+    }
+
+    auto complete(const char* p_name, const char* p_category, const time_point_type start, const time_point_type stop) -> void
+    {
+      if(is_enabled())
+      {
+        local_ring().push(timeline_event { p_name, p_category, ns_since_origin(start), ns(start, stop), false });
+      }
+    }
+
+    auto instant(const char* p_name, const char* p_category) -> void
+    {
+      if(is_enabled())
+      {
+        local_ring().push(timeline_event { p_name, p_category, ns_since_origin(clock_type::now()), ::std::int64_t { INT8_C(0) }, true });
+      }
+    }
+
+  private:
+    ::std::atomic<bool> my_enabled { false };
+    time_point_type     my_origin  { };
+
+    mutable ::std::mutex                            my_rings_mutex { };
+    ::std::vector<::std::shared_ptr<timeline_ring>> my_rings       { };
+
+    ::std::mutex    my_file_mutex  { };
+    ::std::ofstream my_file        { };
+    bool            my_first_event { true };
+
+    mathematica_mathlink_timeline() = default;
+
+    static auto ns(const time_point_type start, const time_point_type stop) -> ::std::int64_t
+    {
+      return static_cast<::std::int64_t>(::std::chrono::duration_cast<::std::chrono::nanoseconds>(stop - start).count());
+    }
+
+    auto ns_since_origin(const time_point_type t) const -> ::std::int64_t { return ns(my_origin, t); }
+
+    auto local_ring() -> timeline_ring&
+    {
+      // Each thread registers its own ring upon its first event.
+      // The ring is shared with the timeline, so that its events
+      // can still be flushed after the thread has ended.
+
+      thread_local ::std::shared_ptr<timeline_ring> p_ring { register_ring() };
+
+      return *p_ring;
+    }
+
+    auto register_ring() -> ::std::shared_ptr<timeline_ring>
+    {
+      const ::std::lock_guard<::std::mutex> lock { my_rings_mutex };
+
+      my_rings.push_back(::std::make_shared<timeline_ring>(static_cast<::std::uint32_t>(my_rings.size() + 1U)));
+
+      return my_rings.back();
+    }
+
+    auto flush_locked() -> void
+    {
+      // The times are written in microseconds, as expected by the format.
+
+      ::std::vector<::std::shared_ptr<timeline_ring>> rings { };
+
+      {
+        const ::std::lock_guard<::std::mutex> lock { my_rings_mutex };
+
+        rings = my_rings;
+      }
+
+      my_file << ::std::fixed << ::std::setprecision(3);
+
+      for(const auto& p_ring : rings)
+      {
+        timeline_event event { };
+
+        while(p_ring->try_pop(&event))
+        {
+          my_file << (my_first_event ? "" : ",\n")
+                  << "{\"name\":\"" << event.name
+                  << "\",\"cat\":\"" << event.category
+                  << "\",\"ph\":\"" << (event.instant ? "i" : "X")
+                  << "\",\"ts\":" << (static_cast<double>(event.start_ns) / 1000.0);
+
+          if(event.instant)
+          {
+            my_file << ",\"s\":\"t\"";
+          }
+          else
+          {
+            my_file << ",\"dur\":" << (static_cast<double>(event.dur_ns) / 1000.0);
+          }
+
+          my_file << ",\"pid\":1,\"tid\":" << p_ring->thread_id() << "}";
+
+          my_first_event = false;
+        }
+      }
+
+      my_file.flush();
+    }
+  };
+
+  class timeline_scope
+  {
+  public:
+    // Record the lifetime of this object as one complete event on the timeline.
+
+    timeline_scope(const char* p_name, const char* p_category)
+      : my_name     { p_name },
+        my_category { p_category },
+        my_enabled  { mathematica_mathlink_timeline::instance().is_enabled() },
+        my_start    { my_enabled ? mathematica_mathlink_timeline::clock_type::now() : mathematica_mathlink_timeline::time_point_type { } } { }
+
+    timeline_scope(const timeline_scope&) = delete;
+    timeline_scope(timeline_scope&&) noexcept = delete;
+
+    ~timeline_scope()
+    {
+      if(my_enabled)
+      {
+        mathematica_mathlink_timeline::instance().complete(my_name, my_category, my_start, mathematica_mathlink_timeline::clock_type::now());
+      }
+    }
+
+    auto operator=(const timeline_scope&) -> timeline_scope& = delete;
+    auto operator=(timeline_scope&&) noexcept -> timeline_scope& = delete;
+
+  private:
+    const char* const                                    my_name;
+    const char* const                                    my_category;
+    const bool                                           my_enabled;
+    const mathematica_mathlink_timeline::time_point_type my_start;
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_MATHLINK_TIMELINE_2026_10_16_H
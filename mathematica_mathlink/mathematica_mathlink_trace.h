@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_MATHLINK_TRACE_2026_10_16_H
+  #define MATHEMATICA_MATHLINK_TRACE_2026_10_16_H
+
+  #include <algorithm>
+  #include <array>
+  #include <cstddef>
+  #include <cstdint>
+  #include <fstream>
+  #include <iterator>
+  #include <string>
+  #include <utility>
+  #include <vector>
+
+  namespace mathematica {
+
+  enum class trace_mode
+  {
+    record,
+    replay
+  };
+
+  enum class trace_op : ::std::uint8_t
+  {
+    next_packet        = UINT8_C(1),
+    new_packet         = UINT8_C(2),
+    end_packet         = UINT8_C(3),
+    error              = UINT8_C(4),
+    put_function       = UINT8_C(5),
+    put_string         = UINT8_C(6),
+    put_symbol         = UINT8_C(7),
+    put_integer64      = UINT8_C(8),
+    put_integer64_list = UINT8_C(9),
+    put_next           = UINT8_C(10),
+    put_size           = UINT8_C(11),
+    put_data           = UINT8_C(12),
+    get_symbol         = UINT8_C(13),
+    get_integer64      = UINT8_C(14),
+    get_real64         = UINT8_C(15),
+    get_integer64_list = UINT8_C(16),
+    get_utf8_string    = UINT8_C(17),
+    test_head          = UINT8_C(18),
+    clear_error        = UINT8_C(19)
+  };
+
+  struct trace_record
+  {
+    // One single WS* call. The result is the return value of the call.
+    // The bytes and the list hold the payload of the call: for a put,
+    // the arguments; for a get, the data received from the kernel.
+
+    trace_op                      op     { trace_op::next_packet };
+    ::std::int64_t                result { };
+    ::std::string                 bytes  { };
+    ::std::vector<::std::int64_t> list   { };
+  };
+
+  class mathematica_mathlink_trace
+  {
+  public:
+    // This is the mathematica_mathlink_trace class. It holds a packet-level
+    // trace of a link session. A link constructed with a trace in record mode
+    // talks to the kernel as usual and writes each WS* call, together with its
+    // payload and its result, into the trace file. A link constructed with a
+    // trace in replay mode does not open a kernel at all. Its WS* calls are
+    // answered from the trace, which is loaded into memory up front. Replay
+    // runs through the very same packet code at full speed, which makes
+    // repeatable link-layer benchmarks possible without a kernel.
+
+    // During replay, the puts are compared with the recorded ones. A put that
+    // differs from the recording fails, and it is counted as a mismatch.
+
+    // The trace file starts with a 16-byte header. Each record then consists of
+    // the operation (one byte), the result, the length of the bytes, the bytes,
+    // the length of the list and the list elements. All of the integers are
+    // written as variable-length (LEB128) integers, the signed ones zig-zag encoded.
+
+    using record_type      = trace_record;
+    using record_list_type = ::std::vector<record_type>;
+
+    mathematica_mathlink_trace(const ::std::string& str_path, const trace_mode mode)
+      : my_mode { mode },
+        my_open { (my_mode == trace_mode::record) ? open_record(str_path) : open_replay(str_path) } { }
+
+    mathematica_mathlink_trace(const mathematica_mathlink_trace&) = delete;
+    mathematica_mathlink_trace(mathematica_mathlink_trace&&) noexcept = delete;
+
+    ~mathematica_mathlink_trace() = default;
+
+    auto operator=(const mathematica_mathlink_trace&) -> mathematica_mathlink_trace& = delete;
+    auto operator=(mathematica_mathlink_trace&&) noexcept -> mathematica_mathlink_trace& = delete;
+
+    auto is_open     () const noexcept -> bool       { return my_open; }
+    auto mode        () const noexcept -> trace_mode { return my_mode; }
+    auto is_recording() const noexcept -> bool       { return (my_mode == trace_mode::record); }
+    auto is_replaying() const noexcept -> bool       { return (my_mode == trace_mode::replay); }
+
+    auto records   () const noexcept -> const record_list_type& { return my_records; }
+    auto position  () const noexcept -> ::std::size_t           { return my_position; }
+    auto at_end    () const noexcept -> bool                    { return (my_position == my_records.size()); }
+    auto mismatches() const noexcept -> ::std::uint64_t         { return my_mismatches; }
+
+    auto rewind() noexcept -> void
+    {
+      // Start the replay over from the beginning of the trace.
+      my_position   = ::std::size_t { UINT8_C(0) };
+      my_mismatches = ::std::uint64_t { UINT8_C(0) };
+    }
+
+    auto record(const trace_op op,
+                const ::std::int64_t result,
+                const char* p_bytes = nullptr,
+                const ::std::size_t byte_count = ::std::size_t { UINT8_C(0) },
+                const ::std::int64_t* p_list = nullptr,
+                const ::std::size_t list_count = ::std::size_t { UINT8_C(0) }) -> void
+    {
+      // Encode the record into a reusable buffer and write it in one go.
+      my_buffer.clear();
+
+      my_buffer.push_back(static_cast<char>(op));
+
+      put_varint(zigzag(result));
+      put_varint(static_cast<::std::uint64_t>(byte_count));
+
+      if(byte_count != ::std::size_t { UINT8_C(0) })
+      {
+        my_buffer.append(p_bytes, byte_count);
+      }
+
+      put_varint(static_cast<::std::uint64_t>(list_count));
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < list_count; ++index)
+      {
+        put_varint(zigzag(p_list[index])); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      }
+
+      static_cast<void>(my_file.write(my_buffer.data(), static_cast<::std::streamsize>(my_buffer.size())));
+    }
+
+    auto replay(const trace_op op) -> const record_type*
+    {
+      // Get the next record of the trace, provided that it
+      // has been recorded for the same operation.
+
+      if(at_end() || (my_records[my_position].op != op))
+      {
+        ++my_mismatches;
+
+        return nullptr;
+      }
+
+      return &my_records[my_position++];
+    }
+
+    auto replay_put(const trace_op op,
+                    const char* p_bytes = nullptr,
+                    const ::std::size_t byte_count = ::std::size_t { UINT8_C(0) },
+                    const ::std::int64_t* p_list = nullptr,
+                    const ::std::size_t list_count = ::std::size_t { UINT8_C(0) }) -> int
+    {
+      // Replay a put (or a call without payload) and check that its
+      // arguments match those of the recording. Return the recorded
+      // result, or zero upon a mismatch.
+
+      const record_type* p_rec { replay(op) };
+
+      if(p_rec == nullptr)
+      {
+        return int { INT8_C(0) };
+      }
+
+      const bool
+        payload_is_same
+        {
+             (p_rec->bytes.size() == byte_count)
+          && (p_rec->list.size()  == list_count)
+          && ((byte_count == ::std::size_t { UINT8_C(0) }) || ::std::equal(p_rec->bytes.cbegin(), p_rec->bytes.cend(), p_bytes))
+          && ((list_count == ::std::size_t { UINT8_C(0) }) || ::std::equal(p_rec->list.cbegin(),  p_rec->list.cend(),  p_list))
+        };
+
+      if(!payload_is_same)
+      {
+        ++my_mismatches;
+
+        return int { INT8_C(0) };
+      }
+
+      return static_cast<int>(p_rec->result);
+    }
+
+  private:
+    using header_type = ::std::array<char, ::std::size_t { UINT8_C(16) }>;
+
+    const trace_mode my_mode;
+    ::std::fstream   my_file       { };
+    record_list_type my_records    { };
+    ::std::size_t    my_position   { };
+    ::std::uint64_t  my_mismatches { };
+    ::std::string    my_buffer     { };
+    const bool       my_open;
+
+    static auto magic() noexcept -> header_type { return header_type { 'M', 'M', 'L', 'T', 'R', 'A', 'C', 'E', '\1' }; }
+
+    static auto zigzag  (const ::std::int64_t  n) noexcept -> ::std::uint64_t { return static_cast<::std::uint64_t>((static_cast<::std::uint64_t>(n) << 1U) ^ static_cast<::std::uint64_t>(n >> 63)); }
+    static auto unzigzag(const ::std::uint64_t u) noexcept -> ::std::int64_t  { return static_cast<::std::int64_t>((u >> 1U) ^ static_cast<::std::uint64_t>(-static_cast<::std::int64_t>(u & 1U))); }
+
+    auto put_varint(::std::uint64_t u) -> void
+    {
+      while(u >= UINT64_C(0x80))
+      {
+        my_buffer.push_back(static_cast<char>(static_cast<::std::uint8_t>(u | UINT64_C(0x80))));
+
+        u >>= 7U;
+      }
+
+      my_buffer.push_back(static_cast<char>(static_cast<::std::uint8_t>(u)));
+    }
+
+    static auto get_varint(const char*& p, const char* p_end, ::std::uint64_t* p_u) noexcept -> bool
+    {
+      ::std::uint64_t u     { };
+      unsigned        shift { };
+
+      for( ; (p != p_end) && (shift < unsigned { UINT8_C(64) }); shift += 7U)
+      {
+        const ::std::uint8_t byte { static_cast<::std::uint8_t>(*p++) };
+
+        u |= static_cast<::std::uint64_t>(static_cast<::std::uint64_t>(byte & UINT8_C(0x7F)) << shift);
+
+        if((byte & UINT8_C(0x80)) == UINT8_C(0))
+        {
+          *p_u = u;
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    auto open_record(const ::std::string& str_path) -> bool
+    {
+      my_file.open(str_path, ::std::ios::out | ::std::ios::binary | ::std::ios::trunc);
+
+      const header_type header { magic() };
+
+      static_cast<void>(my_file.write(header.data(), static_cast<::std::streamsize>(header.size())));
+
+      return my_file.good();
+    }
+
+    auto open_replay(const ::std::string& str_path) -> bool
+    {
+      my_file.open(str_path, ::std::ios::in | ::std::ios::binary);
+
+      const ::std::string
+        str_file
+        {
+          ::std::istreambuf_iterator<char>(my_file),
+          ::std::istreambuf_iterator<char>()
+        };
+
+      my_file.close();
+
+      const header_type header { magic() };
+
+      if((str_file.size() < header.size()) || (!::std::equal(header.cbegin(), header.cend(), str_file.cbegin())))
+      {
+        return false;
+      }
+
+      const char*       p     { str_file.data() + header.size() };
+      const char* const p_end { str_file.data() + str_file.size() };
+
+      while(p != p_end)
+      {
+        record_type rec { };
+
+        rec.op = static_cast<trace_op>(static_cast<::std::uint8_t>(*p++));
+
+        ::std::uint64_t u { };
+
+        if(!get_varint(p, p_end, &u)) { return false; }
+
+        rec.result = unzigzag(u);
+
+        if((!get_varint(p, p_end, &u)) || (u > static_cast<::std::uint64_t>(p_end - p))) { return false; }
+
+        rec.bytes.assign(p, static_cast<::std::size_t>(u));
+
+        p += static_cast<::std::ptrdiff_t>(u);
+
+        if((!get_varint(p, p_end, &u)) || (u > static_cast<::std::uint64_t>(p_end - p))) { return false; }
+
+        rec.list.resize(static_cast<::std::size_t>(u));
+
+        for(auto& elem : rec.list)
+        {
+          if(!get_varint(p, p_end, &u)) { return false; }
+
+          elem = unzigzag(u);
+        }
+
+        my_records.push_back(::std::move(rec));
+      }
+
+      return true;
+    }
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_MATHLINK_TRACE_2026_10_16_H
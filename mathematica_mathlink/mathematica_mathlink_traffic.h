@@ -0,0 +1,171 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MATHEMATICA_MATHLINK_TRAFFIC_2026_10_16_H
+  #define MATHEMATICA_MATHLINK_TRAFFIC_2026_10_16_H
+
+  #include <array>
+  #include <atomic>
+  #include <cstddef>
+  #include <cstdint>
+  #include <iomanip>
+  #include <ios>
+  #include <ostream>
+  #include <string>
+
+  namespace mathematica {
+
+  struct mathematica_mathlink_traffic
+  {
+    // This is a snapshot of the traffic counters of one or more links
+    // (see mathematica_mathlink_base::traffic()). The bytes are those of
+    // the strings, symbols and numbers crossing the link (without framing).
+    // The packets skipped are those that have been read and discarded while
+    // waiting for a ReturnPacket, counted by their packet type. Packet types
+    // beyond the known ones are counted together as (other).
+
+    static constexpr ::std::size_t packet_kinds { ::std::size_t { UINT8_C(22) } };
+
+    ::std::uint64_t                             commands         { };
+    ::std::uint64_t                             bytes_put        { };
+    ::std::uint64_t                             bytes_received   { };
+    ::std::uint64_t                             packets_received { };
+    ::std::array<::std::uint64_t, packet_kinds> packets_skipped  { };
+    ::std::uint64_t                             errors           { };
+
+    static auto packet_index(const int packet_id) noexcept -> ::std::size_t
+    {
+      return (((packet_id > 0) && (static_cast<::std::size_t>(packet_id) < packet_kinds)) ? static_cast<::std::size_t>(packet_id) : ::std::size_t { UINT8_C(0) });
+    }
+
+    static auto packet_name(const ::std::size_t index) noexcept -> const char*
+    {
+      // These are the packet types of WSTP, indexed by their packet id.
+
+      constexpr ::std::array<const char*, packet_kinds>
+        names
+        {{
+          "(other)",          "InputPacket",           "TextPacket",             "ReturnPacket",
+          "ReturnTextPacket", "MessagePacket",         "MenuPacket",             "CallPacket",
+          "InputNamePacket",  "OutputNamePacket",      "SyntaxPacket",           "DisplayPacket",
+          "DisplayEndPacket", "EvaluatePacket",        "EnterTextPacket",        "EnterExpressionPacket",
+          "ReturnExpressionPacket", "SuspendPacket",   "ResumePacket",           "BeginDialogPacket",
+          "EndDialogPacket",  "InputStringPacket"
+        }};
+
+      return names[(index < packet_kinds) ? index : ::std::size_t { UINT8_C(0) }];
+    }
+
+    auto skipped() const noexcept -> ::std::uint64_t
+    {
+      ::std::uint64_t result { };
+
+      for(const ::std::uint64_t count : packets_skipped)
+      {
+        result += count;
+      }
+
+      return result;
+    }
+
+    auto operator+=(const mathematica_mathlink_traffic& other) noexcept -> mathematica_mathlink_traffic&
+    {
+      commands         += other.commands;
+      bytes_put        += other.bytes_put;
+      bytes_received   += other.bytes_received;
+      packets_received += other.packets_received;
+      errors           += other.errors;
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < packet_kinds; ++index)
+      {
+        packets_skipped[index] += other.packets_skipped[index];
+      }
+
+      return *this;
+    }
+
+    auto report(::std::ostream& os) const -> void
+    {
+      // Write one line per counter, followed by one line
+      // per type of packet that has been skipped.
+
+      const ::std::ios_base::fmtflags flags { os.flags() };
+
+      os << ::std::left << ::std::setw(28) << "commands"         << ::std::right << ::std::setw(16) << commands         << '\n'
+         << ::std::left << ::std::setw(28) << "bytes_put"        << ::std::right << ::std::setw(16) << bytes_put        << '\n'
+         << ::std::left << ::std::setw(28) << "bytes_received"   << ::std::right << ::std::setw(16) << bytes_received   << '\n'
+         << ::std::left << ::std::setw(28) << "packets_received" << ::std::right << ::std::setw(16) << packets_received << '\n'
+         << ::std::left << ::std::setw(28) << "packets_skipped"  << ::std::right << ::std::setw(16) << skipped()        << '\n';
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < packet_kinds; ++index)
+      {
+        if(packets_skipped[index] != ::std::uint64_t { UINT8_C(0) })
+        {
+          os << ::std::left << ::std::setw(28) << (::std::string { "  " } + packet_name(index)) << ::std::right << ::std::setw(16) << packets_skipped[index] << '\n';
+        }
+      }
+
+      os << ::std::left << ::std::setw(28) << "errors" << ::std::right << ::std::setw(16) << errors << '\n';
+
+      static_cast<void>(os.flags(flags));
+    }
+  };
+
+  class traffic_counters
+  {
+  public:
+    // These are the live traffic counters of one single link. They are
+    // counted by the thread making the WS* calls and can be read from
+    // any thread. Relaxed atomics suffice, since each counter stands alone.
+
+    auto add_command() noexcept -> void { my_commands.fetch_add(1U, ::std::memory_order_relaxed); }
+    auto add_error  () noexcept -> void { my_errors  .fetch_add(1U, ::std::memory_order_relaxed); }
+
+    auto add_put     (const ::std::size_t byte_count) noexcept -> void { my_bytes_put     .fetch_add(static_cast<::std::uint64_t>(byte_count), ::std::memory_order_relaxed); }
+    auto add_received(const ::std::size_t byte_count) noexcept -> void { my_bytes_received.fetch_add(static_cast<::std::uint64_t>(byte_count), ::std::memory_order_relaxed); }
+
+    auto add_packet(const int packet_id, const bool is_skipped) noexcept -> void
+    {
+      my_packets_received.fetch_add(1U, ::std::memory_order_relaxed);
+
+      if(is_skipped)
+      {
+        my_packets_skipped[mathematica_mathlink_traffic::packet_index(packet_id)].fetch_add(1U, ::std::memory_order_relaxed);
+      }
+    }
+
+    auto snapshot() const noexcept -> mathematica_mathlink_traffic
+    {
+      mathematica_mathlink_traffic result { };
+
+      result.commands         = my_commands        .load(::std::memory_order_relaxed);
+      result.bytes_put        = my_bytes_put       .load(::std::memory_order_relaxed);
+      result.bytes_received   = my_bytes_received  .load(::std::memory_order_relaxed);
+      result.packets_received = my_packets_received.load(::std::memory_order_relaxed);
+      result.errors           = my_errors          .load(::std::memory_order_relaxed);
+
+      for(::std::size_t index { ::std::size_t { UINT8_C(0) } }; index < mathematica_mathlink_traffic::packet_kinds; ++index)
+      {
+        result.packets_skipped[index] = my_packets_skipped[index].load(::std::memory_order_relaxed);
+      }
+
+      return result;
+    }
+
+  private:
+    ::std::atomic<::std::uint64_t> my_commands         { };
+    ::std::atomic<::std::uint64_t> my_bytes_put        { };
+    ::std::atomic<::std::uint64_t> my_bytes_received   { };
+    ::std::atomic<::std::uint64_t> my_packets_received { };
+    ::std::atomic<::std::uint64_t> my_errors           { };
+
+    ::std::array<::std::atomic<::std::uint64_t>, mathematica_mathlink_traffic::packet_kinds> my_packets_skipped { };
+  };
+
+  } // namespace mathematica
+
+#endif // MATHEMATICA_MATHLINK_TRAFFIC_2026_10_16_H
@@ -279,13 +279,7 @@ auto solovay_strassen(const UnsignedIntegerType& np, const int iterations, Distr
 
 namespace prime_q
 {
-  // Use the default mathlink 14.0 kernel location on Win*.
-  constexpr char independent_test_system_mathlink_location[]
-  {
-    "\"C:\\Program Files\\Wolfram Research\\Mathematica\\14.0\\MathKernel.exe\""
-  };
-
-  using local_mathematica_mathlink_type = mathematica::mathematica_mathlink<independent_test_system_mathlink_location>;
+  using local_mathematica_mathlink_type = mathematica::mathematica_mathlink<>;
 
   template<typename DistributionType,
            typename RandomEngineType,
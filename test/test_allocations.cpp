@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Install the counting hook of the global operator new in this program.
+#define MATHEMATICA_MATHLINK_ALLOCATION_HOOK
+
+#include <mathematica_mathlink/mathematica_mathlink.h>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace local {
+
+using mathematica_mathlink_type = mathematica::mathematica_mathlink<>;
+
+// These are the allocation budgets of the link itself for one single round trip,
+// not counting the allocations of the transport (such as the stand-in shim).
+constexpr auto budget_round_trip            = static_cast<std::uint64_t>(UINT8_C(0));
+constexpr auto budget_round_trip_suppressed = static_cast<std::uint64_t>(UINT8_C(1));
+constexpr auto budget_round_trip_budgeted   = static_cast<std::uint64_t>(UINT8_C(0));
+constexpr auto budget_round_trip_async      = static_cast<std::uint64_t>(UINT8_C(6));
+
+auto link_allocations() -> std::uint64_t;
+
+auto link_allocations() -> std::uint64_t
+{
+  const mathematica::mathematica_mathlink_allocations& allocations { mathematica::mathematica_mathlink_allocations::instance() };
+
+  // The unattributed allocations are counted too, since they are made within
+  // the measured round trip (for instance by the link I/O thread).
+  return (allocations.count_in_sites() + allocations.count(nullptr)) - allocations.count("wstp_shim");
+}
+
+template<typename RoundTripType>
+auto check_budget(const char* p_str_name, const std::uint64_t budget, RoundTripType round_trip) -> bool
+{
+  mathematica::mathematica_mathlink_allocations& allocations { mathematica::mathematica_mathlink_allocations::instance() };
+
+  // The first round trip is not counted. It may allocate for buffers that are reused.
+  auto result_is_ok = round_trip();
+
+  std::uint64_t count_max { };
+
+  constexpr auto max_trial = static_cast<std::uint32_t>(UINT16_C(1024));
+
+  for(auto trial = static_cast<std::uint32_t>(UINT8_C(0)); ((trial < max_trial) && result_is_ok); ++trial)
+  {
+    allocations.start();
+
+    result_is_ok = round_trip();
+
+    allocations.stop();
+
+    const std::uint64_t count { link_allocations() };
+
+    if(count > count_max)
+    {
+      count_max = count;
+
+      allocations.report(std::cout);
+    }
+  }
+
+  result_is_ok = ((count_max <= budget) && result_is_ok);
+
+  std::cout << std::left << std::setw(28) << p_str_name
+            << "allocations: " << count_max << " (budget: " << budget << "), "
+            << std::boolalpha << result_is_ok << std::endl;
+
+  return result_is_ok;
+}
+
+} // namespace local
+
+auto main() -> int;
+
+auto main() -> int
+{
+  local::mathematica_mathlink_type mlnk;
+
+  const std::string str_cmd { "GCD[123456789012345678901234567890, 987654321098765432109876543210]" };
+
+  std::string str_rsp { };
+
+  str_rsp.reserve(static_cast<std::size_t>(UINT8_C(64)));
+
+  auto result_total_is_ok = mlnk.is_valid();
+
+  result_total_is_ok =
+    (   local::check_budget("round_trip", local::budget_round_trip,
+                            [&mlnk, &str_cmd, &str_rsp]() { return (mlnk.send_command(str_cmd, &str_rsp) && (str_rsp == "9000000000900000000090")); })
+     && result_total_is_ok);
+
+  result_total_is_ok =
+    (   local::check_budget("round_trip_suppressed", local::budget_round_trip_suppressed,
+                            [&mlnk, &str_cmd]() { return mlnk.send_command(str_cmd, nullptr); })
+     && result_total_is_ok);
+
+  // The kernel budget wraps the command in TimeConstrained and MemoryConstrained.
+  mlnk.set_kernel_budget(std::chrono::milliseconds { 10000 }, static_cast<std::uint64_t>(UINT32_C(0x40000000)));
+
+  result_total_is_ok =
+    (   local::check_budget("round_trip_budgeted", local::budget_round_trip_budgeted,
+                            [&mlnk, &str_cmd, &str_rsp]() { return (mlnk.send_command(str_cmd, &str_rsp) && (str_rsp == "9000000000900000000090")); })
+     && result_total_is_ok);
+
+  mlnk.set_kernel_budget(std::chrono::milliseconds { 0 }, static_cast<std::uint64_t>(UINT8_C(0)));
+
+  // The asynchronous round trip starts the link I/O thread, so it comes last.
+  result_total_is_ok =
+    (   local::check_budget("round_trip_async", local::budget_round_trip_async,
+                            [&mlnk, &str_cmd, &str_rsp]() { return mlnk.send_command_async(str_cmd, &str_rsp).get(); })
+     && result_total_is_ok);
+
+  std::cout << "\nresult_total_is_ok          : " << std::boolalpha << result_total_is_ok << std::endl;
+
+  return (result_total_is_ok ? 0 : -1);
+}
@@ -18,18 +18,9 @@
 #include <iomanip>
 #include <iostream>
 
-namespace local
-{
-  // Use the default mathlink 12.1 kernel location on Win*.
-  constexpr char independent_test_system_mathlink_location[]
-  {
-    "\"C:\\Program Files\\Wolfram Research\\Mathematica\\12.1\\MathKernel.exe\""
-  };
-}
-
 auto main() -> int
 {
-  using local_mathematica_mathlink_type = mathematica::mathematica_mathlink<local::independent_test_system_mathlink_location>;
+  using local_mathematica_mathlink_type = mathematica::mathematica_mathlink<>;
 
   local_mathematica_mathlink_type mlnk;
 
@@ -15,6 +15,8 @@
 #include <iostream>
 #include <random>
 #include <sstream>
+#include <string>
+#include <vector>
 
 namespace local
 {
@@ -145,13 +147,7 @@ namespace local
     return str_result;
   }
 
-  // Use the default mathlink 12.1 kernel location on Win*.
-  constexpr char independent_test_system_mathlink_location[]
-  {
-    "\"C:\\Program Files\\Wolfram Research\\Mathematica\\12.1\\MathKernel.exe\""
-  };
-
-  using mathematica_mathlink_type = mathematica::mathematica_mathlink<independent_test_system_mathlink_location>;
+  using mathematica_mathlink_type = mathematica::mathematica_mathlink<>;
 
   using integral_type = WIDE_INTEGER_NAMESPACE::math::wide_integer::int512_t;
 
@@ -183,7 +179,12 @@ auto main() -> int
 
   auto result_total_is_ok = true;
 
+  // Define MATHEMATICA_MATHLINK_TEST_REDUCED for a short run (such as in CI with the stand-in shim).
+  #if defined(MATHEMATICA_MATHLINK_TEST_REDUCED)
+  constexpr auto max_index = static_cast<std::uint32_t>(UINT32_C(0x4000));
+  #else
   constexpr auto max_index = static_cast<std::uint32_t>(UINT32_C(4000000));
+  #endif
             auto run_index = static_cast<std::uint32_t>(UINT32_C(0));
 
   for( ; ((run_index < max_index) && result_total_is_ok); ++run_index)
@@ -199,15 +200,25 @@ auto main() -> int
     // Last[QuotientRemainder[87727206311238137505326963407487099090735132557053, -273791746447195436717]]
     // -168305638431774838453
 
-    const auto str_quot_rem   = "QuotientRemainder[" + str_left + "," + str_right + "]";
-    const auto str_cmd_first  = "First[" + str_quot_rem + "]";
-    const auto str_cmd_second = "Last [" + str_quot_rem + "]";
+    const auto str_quot_rem = "QuotientRemainder[" + str_left + "," + str_right + "]";
+
+    // Send both commands in one single pipelined batch.
+    const auto str_cmds = std::vector<std::string> { "First[" + str_quot_rem + "]", "Last [" + str_quot_rem + "]" };
+
+    auto str_rsps = std::vector<std::string> { };
 
-    auto str_rsp_first  = std::string { };
-    auto str_rsp_second = std::string { };
+    // The responses are only read when the batch has succeeded as a whole.
+    const auto result_batch_is_ok = (mlnk.send_batch(str_cmds, &str_rsps) && (str_rsps.size() == str_cmds.size()));
+
+    if(!result_batch_is_ok)
+    {
+      result_total_is_ok = false;
+
+      continue;
+    }
 
-    mlnk.send_command(str_cmd_first,  &str_rsp_first);
-    mlnk.send_command(str_cmd_second, &str_rsp_second);
+    const auto& str_rsp_first  = str_rsps.front();
+    const auto& str_rsp_second = str_rsps.back();
 
     const auto n_left  = local::integral_type { str_left.c_str() };
     const auto n_right = local::integral_type { str_right.c_str() };
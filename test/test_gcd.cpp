@@ -14,15 +14,11 @@
 #include <iomanip>
 #include <iostream>
 #include <random>
+#include <string>
+#include <vector>
 
 namespace local
 {
-  // Use the default mathlink 12.1 kernel location on Win*.
-  constexpr char independent_test_system_mathlink_location[]
-  {
-    "\"C:\\Program Files\\Wolfram Research\\Mathematica\\12.1\\MathKernel.exe\""
-  };
-
   template<typename IntegralTimePointType,
            typename ClockType = std::chrono::high_resolution_clock>
   auto time_point() -> IntegralTimePointType
@@ -112,13 +108,18 @@ auto main() -> int;
 
 auto main() -> int
 {
-  using local_mathematica_mathlink_type = mathematica::mathematica_mathlink<local::independent_test_system_mathlink_location>;
+  using local_mathematica_mathlink_type = mathematica::mathematica_mathlink<>;
 
   local_mathematica_mathlink_type mlnk;
 
   auto result_total_is_ok = true;
 
+  // Define MATHEMATICA_MATHLINK_TEST_REDUCED for a short run (such as in CI with the stand-in shim).
+  #if defined(MATHEMATICA_MATHLINK_TEST_REDUCED)
+  constexpr auto max_index = static_cast<std::uint32_t>(UINT32_C(0x1000));
+  #else
   constexpr auto max_index = static_cast<std::uint32_t>(UINT32_C(0x100000));
+  #endif
 
   auto run_index = static_cast<std::uint32_t>(UINT32_C(0));
 
@@ -126,37 +127,66 @@ auto main() -> int
 
   local::gcd_holder gcd_holder_max(static_cast<unsigned>(UINT8_C(0)));
 
-  for( ; ((run_index < max_index) && result_total_is_ok); ++run_index)
+  // Send the GCD commands in pipelined batches.
+  constexpr auto batch_size = static_cast<std::uint32_t>(UINT8_C(64));
+
+  auto gcd_holders = std::vector<local::gcd_holder>(static_cast<std::size_t>(batch_size));
+  auto exprs       = std::vector<mathematica::expression> { };
+  auto str_rsps    = std::vector<std::string> { };
+
+  exprs.reserve(static_cast<std::size_t>(batch_size));
+
+  for( ; ((run_index < max_index) && result_total_is_ok); run_index += batch_size)
   {
-    auto u = local::wide_integer_type { };
-    auto v = local::wide_integer_type { };
+    exprs.clear();
 
-    local::get_pseudo_random_wide_integers(&u, &v);
+    for(auto index = static_cast<std::size_t>(UINT8_C(0)); index < gcd_holders.size(); ++index)
+    {
+      auto u = local::wide_integer_type { };
+      auto v = local::wide_integer_type { };
 
-    local::gcd_holder gh(u, v);
+      local::get_pseudo_random_wide_integers(&u, &v);
 
-    gh.compute();
+      local::gcd_holder& gh = gcd_holders[index];
 
-    const auto str_cmd = "GCD[" + to_string(gh.get_u()) + "," + to_string(gh.get_v()) + "]";
+      gh.set_u(u);
+      gh.set_v(v);
 
-    auto str_rsp = std::string { };
+      gh.compute();
 
-    mlnk.send_command(str_cmd, &str_rsp);
+      // Send the operands in binary form directly from their limbs.
+      exprs.push_back
+      (
+        mathematica::head("GCD")
+          .arg_limbs(gh.get_u().crepresentation().cbegin(), gh.get_u().crepresentation().cend())
+          .arg_limbs(gh.get_v().crepresentation().cbegin(), gh.get_v().crepresentation().cend())
+      );
+    }
+
+    // The responses are only read when the batch has succeeded as a whole.
+    const auto result_batch_is_ok = (mlnk.send_expression_batch(exprs, &str_rsps) && (str_rsps.size() == gcd_holders.size()));
 
-    const auto result_gcd_is_ok = (local::wide_integer_type(str_rsp.c_str()) == gh.get_result());
+    result_total_is_ok = (result_batch_is_ok && result_total_is_ok);
 
-    if(gh.get_result() > gcd_holder_max.get_result())
+    for(auto index = static_cast<std::size_t>(UINT8_C(0)); index < gcd_holders.size(); ++index)
     {
-      gcd_holder_max = gh;
+      const local::gcd_holder& gh = gcd_holders[index];
 
-      std::cout << "max GCD:"
-                << "\nu: " << gcd_holder_max.get_u() << '\n'
-                << "v: " << gcd_holder_max.get_v()
-                << "\ngcd(u, v) : "
-                << gcd_holder_max.get_result() << '\n';
-    }
+      const auto result_gcd_is_ok = (result_batch_is_ok && (local::wide_integer_type(str_rsps[index].c_str()) == gh.get_result()));
+
+      if(gh.get_result() > gcd_holder_max.get_result())
+      {
+        gcd_holder_max = gh;
 
-    result_total_is_ok = (result_gcd_is_ok && result_total_is_ok);
+        std::cout << "max GCD:"
+                  << "\nu: " << gcd_holder_max.get_u() << '\n'
+                  << "v: " << gcd_holder_max.get_v()
+                  << "\ngcd(u, v) : "
+                  << gcd_holder_max.get_result() << '\n';
+      }
+
+      result_total_is_ok = (result_gcd_is_ok && result_total_is_ok);
+    }
   }
 
   result_total_is_ok = ((run_index == max_index) && result_total_is_ok);
@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <mathematica_mathlink/mathematica_mathlink.h>
+#include <mathematica_mathlink/mathematica_mathlink_oracle.h>
+#include <mathematica_mathlink/mathematica_mathlink_store.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace local {
+
+using mathematica_mathlink_type = mathematica::mathematica_mathlink<>;
+
+auto check(const char* p_str_name, const bool result_is_ok) -> bool;
+
+auto check(const char* p_str_name, const bool result_is_ok) -> bool
+{
+  std::cout << std::left << std::setw(40) << p_str_name << std::boolalpha << result_is_ok << std::endl;
+
+  return result_is_ok;
+}
+
+auto test_arg_uint64_max(mathematica_mathlink_type& mlnk) -> bool;
+
+auto test_arg_uint64_max(mathematica_mathlink_type& mlnk) -> bool
+{
+  // An unsigned argument beyond the range of int64 must not wrap around.
+
+  std::string str_rsp { };
+
+  const bool
+    result_is_ok
+    {
+         mlnk.send_expression(mathematica::head("Plus").arg(UINT64_MAX).arg(1), &str_rsp)
+      && (str_rsp == "18446744073709551616")
+    };
+
+  return check("arg_uint64_max", result_is_ok);
+}
+
+auto test_store_unopened() -> bool;
+
+auto test_store_unopened() -> bool
+{
+  // A store whose files can not be opened still answers from the kernel.
+  // The responses that could not be stored are counted as store errors.
+
+  const mathematica::mathematica_mathlink_store<mathematica_mathlink_type> store { "no_such_directory/test_link.store" };
+
+  std::string str_rsp { };
+
+  const bool
+    result_is_ok
+    {
+         (!store.store_is_valid())
+      && store.send_command("GCD[12, 18]", &str_rsp)
+      && (str_rsp == "6")
+      && (store.store_errors() == static_cast<std::uint64_t>(UINT8_C(1)))
+      && store.is_valid()
+    };
+
+  return check("store_unopened", result_is_ok);
+}
+
+auto test_get_error_is_not_death() -> bool;
+
+auto test_get_error_is_not_death() -> bool
+{
+  // A response of the wrong type fails the call, but it must neither
+  // recover the link (as if the kernel had died) nor break the next call.
+
+  mathematica_mathlink_type mlnk_recovering { };
+
+  mlnk_recovering.set_recovery(mathematica::mathematica_mathlink_recovery { true, true, std::string { } });
+
+  std::int64_t value { };
+
+  std::string str_rsp { };
+
+  const bool
+    result_is_ok
+    {
+         (!mlnk_recovering.evaluate(mathematica::head("PrimeQ").arg(7), &value))
+      && mlnk_recovering.is_alive()
+      && mlnk_recovering.send_command("GCD[12, 18]", &str_rsp)
+      && (str_rsp == "6")
+      && (mlnk_recovering.recoveries() == static_cast<std::uint64_t>(UINT8_C(0)))
+    };
+
+  return check("get_error_is_not_death", result_is_ok);
+}
+
+auto test_oracle_traffic() -> bool;
+
+auto test_oracle_traffic() -> bool
+{
+  // An oracle without a fallback link (needing no kernel at all) has no traffic.
+  // It declines what it can not answer exactly as the kernel does, such as 0^0
+  // (which the kernel answers with Indeterminate).
+
+  const mathematica::mathematica_mathlink_oracle oracle { };
+
+  std::string str_rsp { };
+
+  const bool
+    result_is_ok
+    {
+         oracle.send_command("GCD[12, 18]", &str_rsp)
+      && (str_rsp == "6")
+      && (!oracle.send_command("Power[0, 0]", &str_rsp))
+      && oracle.send_command("Power[0, 1]", &str_rsp)
+      && (str_rsp == "0")
+      && (oracle.declined() == static_cast<std::uint64_t>(UINT8_C(1)))
+      && (oracle.traffic().commands == static_cast<std::uint64_t>(UINT8_C(0)))
+    };
+
+  return check("oracle_traffic", result_is_ok);
+}
+
+auto median_round_trip(mathematica_mathlink_type& mlnk) -> std::chrono::nanoseconds;
+
+auto median_round_trip(mathematica_mathlink_type& mlnk) -> std::chrono::nanoseconds
+{
+  constexpr auto count_of_trips = static_cast<std::size_t>(UINT16_C(1024));
+
+  std::vector<std::chrono::nanoseconds> durations { };
+
+  durations.reserve(count_of_trips);
+
+  std::string str_rsp { };
+
+  for(auto trip = static_cast<std::size_t>(UINT8_C(0)); trip < count_of_trips; ++trip)
+  {
+    const auto start = std::chrono::steady_clock::now();
+
+    static_cast<void>(mlnk.send_command("GCD[12, 18]", &str_rsp));
+
+    durations.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+  }
+
+  std::nth_element(durations.begin(), durations.begin() + (count_of_trips / 2U), durations.end());
+
+  return durations[count_of_trips / 2U];
+}
+
+auto test_deadline_latency() -> bool;
+
+auto test_deadline_latency() -> bool
+{
+  // A deadline far away must not slow down a call that finishes well inside it.
+  // The median round trip with a deadline may exceed the one without a deadline
+  // by a few microseconds of polling at most.
+
+  mathematica_mathlink_type mlnk_timed { };
+
+  const auto median_without = median_round_trip(mlnk_timed);
+
+  mlnk_timed.set_timeout(std::chrono::seconds { 10 });
+
+  const auto median_with = median_round_trip(mlnk_timed);
+
+  std::cout << "median round trip without/with deadline: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(median_without).count() << "us / "
+            << std::chrono::duration_cast<std::chrono::microseconds>(median_with).count()    << "us" << std::endl;
+
+  const bool result_is_ok { median_with <= ((median_without * 2) + std::chrono::microseconds { 20 }) };
+
+  return check("deadline_latency", result_is_ok);
+}
+
+} // namespace local
+
+auto main() -> int;
+
+auto main() -> int
+{
+  local::mathematica_mathlink_type mlnk;
+
+  auto result_total_is_ok = local::check("is_valid", mlnk.is_valid());
+
+  result_total_is_ok = (local::test_arg_uint64_max(mlnk)      && result_total_is_ok);
+  result_total_is_ok = (local::test_store_unopened()         && result_total_is_ok);
+  result_total_is_ok = (local::test_get_error_is_not_death() && result_total_is_ok);
+  result_total_is_ok = (local::test_oracle_traffic()         && result_total_is_ok);
+  result_total_is_ok = (local::test_deadline_latency()       && result_total_is_ok);
+
+  std::cout << "\nresult_total_is_ok                      : " << std::boolalpha << result_total_is_ok << std::endl;
+
+  return (result_total_is_ok ? 0 : -1);
+}
@@ -9,6 +9,7 @@
 
 #include <boost/int128.hpp>
 
+#include <array>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
@@ -279,13 +280,22 @@ auto solovay_strassen(const UnsignedIntegerType& np, const int iterations, Distr
 
 namespace prime_q
 {
-  // Use the default mathlink 14.0 kernel location on Win*.
-  constexpr char independent_test_system_mathlink_location[]
+  using local_mathematica_mathlink_type = mathematica::mathematica_mathlink<>;
+
+  auto prime_q_expression(const boost::int128::uint128& n) -> mathematica::expression;
+
+  auto prime_q_expression(const boost::int128::uint128& n) -> mathematica::expression
   {
-    "\"C:\\Program Files\\Wolfram Research\\Mathematica\\14.0\\MathKernel.exe\""
-  };
+    // Send the 128-bit integer in binary form from its two 64-bit limbs.
+    const ::std::array<::std::uint64_t, ::std::size_t { UINT8_C(2) }>
+      limbs
+      {
+        static_cast<::std::uint64_t>(n),
+        static_cast<::std::uint64_t>(n >> unsigned { UINT8_C(64) })
+      };
 
-  using local_mathematica_mathlink_type = mathematica::mathematica_mathlink<independent_test_system_mathlink_location>;
+    return mathematica::head("PrimeQ").arg_limbs(limbs.cbegin(), limbs.cend());
+  }
 
   template<typename DistributionType,
            typename RandomEngineType,
@@ -495,15 +505,11 @@ namespace prime_q
         // If a non-null Mathlink object has been provided, then check
         // each suspected non-prime for non-primality also via Mathlink.
 
-        const ::std::string str_non_prime_candidate { to_string(p0) };
-
-        const ::std::string str_cmd { "PrimeQ[" + str_non_prime_candidate + "]" };
+        bool result_ml_is_prime { true };
 
-        ::std::string str_rsp { };
+        const bool result_evaluate_is_ok { p_mlink->evaluate(prime_q_expression(p0), &result_ml_is_prime) };
 
-        p_mlink->send_command(str_cmd, &str_rsp);
-
-        const bool result_non_prime_candidate_is_ok { (str_rsp.find("False") != ::std::string::npos) };
+        const bool result_non_prime_candidate_is_ok { (result_evaluate_is_ok && (!result_ml_is_prime)) };
 
         result_total_is_ok = (result_non_prime_candidate_is_ok && result_total_is_ok);
 
@@ -602,13 +608,11 @@ auto main() -> int
 
     const ::std::string str_prime_candidate { to_string(prime_candidate) };
 
-    const ::std::string str_cmd { "PrimeQ[" + str_prime_candidate + "]" };
-
-    ::std::string str_rsp { };
+    bool result_ml_is_prime { false };
 
-    mlnk.send_command(str_cmd, &str_rsp);
+    const bool result_evaluate_is_ok { mlnk.evaluate(prime_q::prime_q_expression(prime_candidate), &result_ml_is_prime) };
 
-    const bool result_prime_candidate_is_ok { (str_rsp.find("True") != ::std::string::npos) };
+    const bool result_prime_candidate_is_ok { (result_evaluate_is_ok && result_ml_is_prime) };
 
     result_total_is_ok = (result_prime_candidate_is_ok && result_total_is_ok);
 
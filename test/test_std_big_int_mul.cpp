@@ -11,6 +11,8 @@
 #include <beman/big_int/charconv.hpp>
 
 #include <chrono>
+#include <cstdlib>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <random>
@@ -151,13 +153,7 @@ auto to_hex_string(integral_type value_to_convert) -> std::string {
     return result;
 }
 
-// Use the default mathlink 12.1 kernel location on Win*.
-constexpr char independent_test_system_mathlink_location[]
-{
-  "\"C:\\Program Files\\Wolfram Research\\Mathematica\\12.1\\MathKernel.exe\""
-};
-
-using mathematica_mathlink_type = mathematica::mathematica_mathlink<independent_test_system_mathlink_location>;
+using mathematica_mathlink_type = mathematica::mathematica_mathlink<>;
 
 } // namespace local
 
@@ -165,9 +161,24 @@ auto main() -> int
 {
   local::mathematica_mathlink_type mlnk;
 
+  // Record a timeline (Chrome trace JSON, for Perfetto) if requested.
+  const char* p_str_timeline { std::getenv("MATHEMATICA_MATHLINK_TIMELINE") }; // NOLINT(concurrency-mt-unsafe)
+
+  mathematica::mathematica_mathlink_timeline& timeline { mathematica::mathematica_mathlink_timeline::instance() };
+
+  if(p_str_timeline != nullptr)
+  {
+    static_cast<void>(timeline.start(p_str_timeline));
+  }
+
   auto result_total_is_ok = true;
 
+  // Define MATHEMATICA_MATHLINK_TEST_REDUCED for a short run (such as in CI with the stand-in shim).
+  #if defined(MATHEMATICA_MATHLINK_TEST_REDUCED)
+  constexpr auto max_trial = static_cast<std::uint32_t>(UINT32_C(1024));
+  #else
   constexpr auto max_trial = static_cast<std::uint32_t>(UINT32_C(131072));
+  #endif
             auto trial = static_cast<std::uint32_t>(UINT32_C(0));
 
   std::uint64_t elapsed_total_muls { };
@@ -202,12 +213,18 @@ auto main() -> int
 
     std::string str_rsp_mul { };
 
-    mlnk.send_command(str_cmd_mul, &str_rsp_mul);
+    // Let the kernel evaluate the product while we compute it locally.
+    std::future<bool> future_rsp_mul { mlnk.send_command_async(str_cmd_mul, &str_rsp_mul) };
 
     {
       const auto start { std::chrono::high_resolution_clock::now() };
 
-      const local::integral_type mul_result = bn_a * bn_b;
+      const local::integral_type mul_result = [&bn_a, &bn_b]()
+      {
+        const mathematica::timeline_scope scope_mul { "local compute", "driver" };
+
+        return bn_a * bn_b;
+      }();
 
       const auto stop { std::chrono::high_resolution_clock::now() };
 
@@ -215,7 +232,17 @@ auto main() -> int
 
       elapsed_total_muls = elapsed_total_muls + static_cast<std::uint64_t>(elapsed_one_mul);
 
-      const bool result_mul_is_ok { (str_rsp_mul  == local::to_hex_string(mul_result)) };
+      const bool result_send_is_ok
+      {
+        [&future_rsp_mul]()
+        {
+          const mathematica::timeline_scope scope_wait { "wait response", "driver" };
+
+          return future_rsp_mul.get();
+        }()
+      };
+
+      const bool result_mul_is_ok { result_send_is_ok && (str_rsp_mul  == local::to_hex_string(mul_result)) };
 
       result_total_is_ok = (result_mul_is_ok && result_total_is_ok);
     }
@@ -232,10 +259,14 @@ auto main() -> int
 
           std::cout << strm.str() << std::endl;
         }
+
+        timeline.flush();
       }
     }
   }
 
+  timeline.stop();
+
   result_total_is_ok = ((trial == max_trial) && result_total_is_ok);
 
   {
@@ -244,6 +275,9 @@ auto main() -> int
     strm << '\n';
     strm << "Summary                            : " << trial      << " trial"           << '\n';
     strm << "result_total_is_ok                 : " << std::boolalpha << result_total_is_ok  << '\n';
+    strm << '\n';
+
+    mlnk.traffic().report(strm);
 
     std::cout << strm.str() << std::endl;
   }